@@ -15,6 +15,11 @@
 /* source management */
 #define ADC_C
 
+/* integrating measurement */
+#define INT_SAMPLES           64        /* samples per burst */
+#define INT_BURST_TIME        20000     /* duration of burst (s) */
+#define INT_MAX_BURSTS        16        /* max. number of bursts */
+
 
 /*
  *  include header files
@@ -211,11 +216,310 @@ uint16_t ReadU_20ms(uint8_t Channel)
 
 
 
+/* ************************************************************************
+ *   transient capture
+ * ************************************************************************ */
+
+
+#ifdef FUNC_ADC_CAPTURE
+
+/*
+ *  start transient capture
+ *  - ADC is auto-triggered by Timer1 compare match B
+ *  - Timer1 runs in CTC mode (TOP = OCR1A) with a prescaler of 64
+ *  - sample n is taken at n * interval after the start
+ *  - apply the stimulus right before calling this function
+ *
+ *  requires:
+ *  - Channel: ADC MUX input channel
+ *  - Ref: voltage reference (ADC_REF_VCC or ADC_REF_BANDGAP)
+ *  - Ticks: sampling interval in timer ticks (64 MCU cycles)
+ *    min. interval is about 15 ADC cycles (120s for 125kHz ADC clock)
+ */
+
+void ADC_CaptureStart(uint8_t Channel, uint8_t Ref, uint16_t Ticks)
+{
+  /* set input channel and voltage reference */
+  Channel &= ADC_CHAN_MASK;        /* filter reg bits for MUX channel */
+  ADMUX = Channel | Ref;
+
+  if (Ref != Cfg.Ref)              /* reference source has changed */
+  {
+    /* wait some time for voltage stabilization */
+    #ifndef ADC_LARGE_BUFFER_CAP
+      /* buffer cap: 1nF or none at all */
+      wait100us();                   /* 100 s */
+    #else
+      /* buffer cap: 100nF */
+      wait10ms();                    /* 10 ms */
+    #endif
+
+    Cfg.Ref = Ref;                 /* update reference source */
+  }
+
+  /* set up Timer1: CTC mode, timer stopped */
+  TCCR1B = 0;                      /* stop timer */
+  TCCR1A = 0;                      /* normal port operation */
+  TCNT1 = 0;                       /* reset counter */
+  OCR1A = Ticks - 1;               /* sampling interval */
+  OCR1B = Ticks - 1;               /* trigger for ADC */
+  /* clear flags (compare A & B, overflow) */
+  TIFR1 = (1 << OCF1B) | (1 << OCF1A) | (1 << TOV1);
+
+  /* ADC auto-trigger: Timer1 compare match B */
+  ADCSRB = (1 << ADTS2) | (1 << ADTS0);
+  ADCSRA = (1 << ADEN) | (1 << ADATE) | (1 << ADIF) | ADC_CLOCK_DIV;
+
+  /* start timer: CTC mode, prescaler 64 */
+  TCCR1B = (1 << WGM12) | (1 << CS11) | (1 << CS10);
+}
+
+
+
+/*
+ *  change sampling interval of running transient capture
+ *  - takes effect after the next sample
+ *  - call right after ADC_CaptureSample()
+ *
+ *  requires:
+ *  - Ticks: new sampling interval in timer ticks
+ */
+
+void ADC_CaptureInterval(uint16_t Ticks)
+{
+  OCR1A = Ticks - 1;               /* sampling interval */
+  OCR1B = Ticks - 1;               /* trigger for ADC */
+}
+
+
+
+/*
+ *  get next sample of transient capture
+ *  - waits for the next conversion triggered by the timer
+ *
+ *  returns:
+ *  - ADC reading (raw value)
+ */
+
+uint16_t ADC_CaptureSample(void)
+{
+  uint16_t          Value;         /* return value */
+
+  /* wait until conversion is done */
+  while (! (ADCSRA & (1 << ADIF)));
+
+  Value = ADCW;                    /* get ADC reading */
+  ADCSRA |= (1 << ADIF);           /* clear ADC flag */
+  TIFR1 = (1 << OCF1B);            /* clear flag to allow next trigger */
+
+  return Value;
+}
+
+
+
+/*
+ *  capture burst of samples
+ *
+ *  requires:
+ *  - Buffer: pointer to sample buffer
+ *  - Count: number of samples
+ */
+
+void ADC_Capture(uint16_t *Buffer, uint8_t Count)
+{
+  while (Count > 0)                /* sample loop */
+  {
+    *Buffer = ADC_CaptureSample(); /* save sample */
+    Buffer++;                      /* next one */
+    Count--;
+    wdt_reset();                   /* reset watchdog */
+  }
+}
+
+
+
+/*
+ *  stop transient capture
+ *  - stops Timer1 and restores ADC
+ */
+
+void ADC_CaptureStop(void)
+{
+  TCCR1B = 0;                      /* stop timer */
+  /* clear flags (compare A & B, overflow) */
+  TIFR1 = (1 << OCF1B) | (1 << OCF1A) | (1 << TOV1);
+  ADCSRB = 0;                      /* no auto-trigger */
+  /* disable auto-trigger */
+  ADCSRA = (1 << ADEN) | (1 << ADIF) | ADC_CLOCK_DIV;
+}
+
+
+
+/*
+ *  convert raw ADC reading of transient capture to voltage
+ *
+ *  requires:
+ *  - Value: ADC reading
+ *  - Ref: voltage reference used (ADC_REF_VCC or ADC_REF_BANDGAP)
+ *
+ *  returns:
+ *  - voltage in mV
+ */
+
+uint16_t ADC_CaptureU(uint16_t Value, uint8_t Ref)
+{
+  uint32_t          U;             /* voltage */
+
+  U = Value;                       /* ADC reading */
+
+  if (Ref == ADC_REF_BANDGAP)      /* bandgap reference */
+  {
+    U *= Cfg.Bandgap;              /* * U_ref */
+  }
+  else                             /* Vcc as reference */
+  {
+    U *= Cfg.Vcc;                  /* * U_ref */
+  }
+
+  U /= 1024;                       /* / 1024 for 10-bit ADC */
+
+  return (uint16_t)U;
+}
+
+#endif
+
+
+
+/* ************************************************************************
+ *   integrating measurement
+ * ************************************************************************ */
+
+
+#ifdef SW_LEAKAGE_AUTO
+
+/*
+ *  read ADC channel with adaptive integration time
+ *  - for low and slowly settling voltages (leakage currents)
+ *  - bursts of samples gated by Timer1, each burst spans 20ms to
+ *    suppress 50/60Hz hum
+ *  - starts with bandgap reference, switches to Vcc for high voltages
+ *  - a burst deviating from the previous one restarts the integration
+ *    window (still settling)
+ *  - window size depends on level (low voltages need more bursts for
+ *    sub-LSB resolution), returns as soon as window is complete
+ *  - max. INT_MAX_BURSTS bursts (about 320ms)
+ *
+ *  requires:
+ *  - Channel: ADC MUX input channel
+ *
+ *  returns:
+ *  - voltage in V
+ */
+
+uint32_t ReadU_Integrated(uint8_t Channel)
+{
+  uint8_t           Ref = ADC_REF_BANDGAP;   /* voltage reference */
+  uint8_t           Runs = 0;      /* number of bursts */
+  uint8_t           Bursts = 0;    /* bursts in window */
+  uint8_t           Window;        /* required bursts for window */
+  uint8_t           n;             /* counter */
+  uint16_t          Sum;           /* sum of ADC readings */
+  uint16_t          LSB;           /* about 1 LSB (V) = U_ref (mV) */
+  uint32_t          U;             /* voltage of burst (V) */
+  uint32_t          U_Last = 0;    /* voltage of last burst (V) */
+  uint32_t          Diff;          /* difference */
+  uint32_t          Tolerance;     /* tolerance for difference */
+  uint32_t          Total = 0;     /* sum of window (V) */
+
+  /* sampling interval in timer ticks (64 MCU cycles) */
+  #define INT_TICKS   ((INT_BURST_TIME / INT_SAMPLES) * MCU_CYCLES_PER_US / 64)
+
+  LSB = Cfg.Bandgap;               /* bandgap reference */
+
+  ADC_CaptureStart(Channel, Ref, INT_TICKS);
+
+  while (Runs < INT_MAX_BURSTS)
+  {
+    /* take burst */
+    Sum = 0;
+    n = 0;
+    while (n < INT_SAMPLES)
+    {
+      Sum += ADC_CaptureSample();  /* add ADC reading */
+      n++;
+    }
+    wdt_reset();                   /* reset watchdog */
+    Runs++;                        /* another burst done */
+
+    /* auto-range: switch to Vcc reference for high voltages */
+    if ((Ref == ADC_REF_BANDGAP) && (Sum > (INT_SAMPLES * 1000U)))
+    {
+      ADC_CaptureStop();
+      Ref = ADC_REF_VCC;           /* Vcc reference */
+      LSB = Cfg.Vcc;
+      ADC_CaptureStart(Channel, Ref, INT_TICKS);
+      continue;                    /* next burst */
+    }
+
+    /* convert to voltage: U = Sum * U_ref / 1024 / samples */
+    U = (uint32_t)Sum * LSB;       /* * U_ref (mV) */
+    U /= INT_SAMPLES;              /* / samples */
+    U *= 125;                      /* * 1000 / 1024 (mV -> V) */
+    U /= 128;
+
+    /*
+     *  check stability
+     *  - tolerance: 1/32 of value, but at least 1 LSB
+     */
+
+    if (U > U_Last) Diff = U - U_Last;
+    else Diff = U_Last - U;
+
+    Tolerance = U / 32;            /* relative tolerance */
+    if (Tolerance < LSB) Tolerance = LSB;     /* min. 1 LSB */
+
+    if ((Bursts > 0) && (Diff <= Tolerance))  /* stable */
+    {
+      Total += U;                  /* add to window */
+      Bursts++;
+    }
+    else                           /* (re)start window */
+    {
+      Total = U;
+      Bursts = 1;
+    }
+
+    U_Last = U;
+
+    /* window size based on level (in LSBs) */
+    Window = 2;                              /* >= 64 LSB */
+    if (U < (uint32_t)LSB * 64) Window = 4;  /* 8 - 63 LSB */
+    if (U < (uint32_t)LSB * 8) Window = 8;   /* < 8 LSB */
+
+    if (Bursts >= Window) break;   /* window complete */
+  }
+
+  ADC_CaptureStop();
+
+  #undef INT_TICKS
+
+  return (Total / Bursts);
+}
+
+#endif
+
+
+
 /* ************************************************************************
  *   clean-up of local constants
  * ************************************************************************ */
 
 
+/* local constants */
+#undef INT_SAMPLES
+#undef INT_BURST_TIME
+#undef INT_MAX_BURSTS
+
 /* source management */
 #undef ADC_C
 
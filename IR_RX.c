@@ -47,15 +47,42 @@
 #define IR_THOMAS        0b00000010     /* Thomas bit encoding */
 #define IR_PRE_PAUSE     0b00000100     /* heading pause */
 
-/* timing control flags (bitfield) */
-#define IR_STD_TOLER     0b00000000     /* use default tolerance */
-#define IR_RELAX_SHORT   0b00000001     /* relax short pulses */
-#define IR_RELAX_LONG    0b00000010     /* relax long pulses */
+/* timing control flags: see common.h */
+
+/* max. number of protocol candidates for PDM decoder table */
+/* (number of entries in IR_PDM_Table, so no candidate is lost) */
+#ifdef SW_IR_RX_EXTRA
+  #define IR_CAND_MAX             6
+#else
+  #define IR_CAND_MAX             4
+#endif
 
 /* signal types */
 #define IR_PAUSE         0b00000001     /* pause */
 #define IR_PULSE         0b00000010     /* pulse */
 
+#ifdef SW_IR_RX_CAPTURE
+  /* ring buffer for edge timing (size has to be 2^n) */
+  /* (holds the longest packet, see MAX_PULSES in IR_Detector()) */
+  #define IR_RING_SIZE          128     /* number of entries */
+  #define IR_RING_MASK          (IR_RING_SIZE - 1)
+
+  /* Timer1 with prescaler 8 */
+  #define IR_TICKS_50US         (CPU_FREQ / 8 / 20000)    /* ticks per 50s */
+  #define IR_TICKS_TIMEOUT      (IR_TICKS_50US * 240)     /* 12ms timeout */
+
+  /* special durations (regular ones are up to the timeout) */
+  #define IR_GAP                UINT8_MAX           /* gap between packets */
+  #define IR_LOST               (UINT8_MAX - 1)     /* lost edges */
+
+  /* probe connected to data pin of IR receiver module */
+  #if defined (SW_IR_RX_PINOUT_G_V_D)
+    #define IR_DATA_PROBE       TP3
+  #else
+    #define IR_DATA_PROBE       TP1
+  #endif
+#endif
+
 
 /*
  *  local variables
@@ -67,6 +94,15 @@ uint8_t             IR_State = 0;            /* multi packet protocol state */
 /* multi packet data fields */
 uint8_t             IR_Data_1;               /* data field #1 */
 
+#ifdef SW_IR_RX_CAPTURE
+/* edge timing logged by ISR */
+volatile uint8_t    IR_Ring[IR_RING_SIZE];   /* time between edges (in 50s) */
+volatile uint8_t    IR_Head;                 /* write position (ISR) */
+volatile uint8_t    IR_Tail;                 /* read position */
+volatile uint8_t    IR_Overflow;             /* ring buffer overflow */
+uint16_t            IR_LastEdge;             /* timestamp of last edge */
+#endif
+
 
 
 /* ************************************************************************
@@ -761,6 +797,211 @@ uint8_t GetBits(uint8_t StartBit, uint8_t Bits, uint8_t Mode)
 
 
 
+/*
+ *  decode IR protocols with start sequence and PDM by table
+ *  - checks all protocols of IR_PDM_Table matching the start sequence
+ *    within a single pass over the pulse data
+ *  - candidates share the demodulated bit stream, a candidate
+ *    disagreeing about a bit is dropped
+ *  - IR_CAND_MAX covers all table entries, i.e. every matching
+ *    protocol becomes a candidate
+ *  - first complete candidate in table order wins
+ *
+ *  requires:
+ *  - pointer to pulse/pause duration data
+ *    first item has to be the start pulse
+ *  - number of pulses/pauses
+ *  - pointer to protocol data (for result)
+ *
+ *  returns:
+ *  - 0 if no protocol matches the start sequence
+ *  - 1 for bad packet (only for IR_TAB_BAD)
+ *  - 2 for valid packet
+ */
+
+uint8_t IR_PDM_Decode(uint8_t *PulseData, uint8_t Pulses, IR_PDM_Type *Proto)
+{
+  uint8_t           Flag = 0;           /* return value */
+  IR_PDM_Type       Cand[IR_CAND_MAX];  /* candidates */
+  IR_PDM_Type       *Entry;             /* pointer to candidate */
+  uint8_t           *Addr;              /* address pointer */
+  uint8_t           *Data;              /* data pointer */
+  uint8_t           Start;              /* bitfield: candidates matching start */
+  uint8_t           Live;               /* bitfield: remaining candidates */
+  uint8_t           Done;               /* bitfield: complete packets */
+  uint8_t           Sealed = 0;         /* bitfield: packets followed by other data */
+  uint8_t           Mask;               /* bit mask for candidate */
+  uint8_t           Time;               /* pulse duration (in 50s) */
+  uint8_t           Bit;                /* bit: 0 invalid, 1 for 0, 2 for 1 */
+  uint8_t           Set;                /* bit decision for all candidates */
+  uint8_t           Counter = 0;        /* number of bits */
+  uint8_t           Pulse = 2;          /* pulse counter */
+  uint8_t           n = 0;              /* number of candidates */
+  uint8_t           m;                  /* counter */
+
+  if (Pulses < 3) return Flag;     /* not enough pulses */
+
+
+  /*
+   *  collect candidates matching the start sequence
+   */
+
+  Addr = (uint8_t *)&IR_PDM_Table;      /* start address of table */
+
+  while (n < IR_CAND_MAX)
+  {
+    /* read table entry */
+    Data = (uint8_t *)&Cand[n];
+    m = sizeof(IR_PDM_Type);
+    while (m > 0)
+    {
+      *Data = DATA_read_byte(Addr);     /* read byte */
+      Data++;                           /* next byte */
+      Addr++;
+      m--;
+    }
+
+    if (Cand[n].Pulse == 0) break;      /* end of table */
+
+    /* check start pulse and pause */
+    if (PulseCheck(PulseData[0], Cand[n].Pulse, Cand[n].PulseCtrl) &&
+        PulseCheck(PulseData[1], Cand[n].Pause, Cand[n].PauseCtrl))
+    {
+      n++;                              /* keep candidate */
+    }
+  }
+
+  if (n == 0) return Flag;         /* no candidate */
+
+  Start = (1 << n) - 1;            /* all candidates */
+  Live = Start;
+  Done = 0;
+
+  /* clear code buffer */
+  for (m = 0; m < IR_CODE_BYTES; m++) IR_Code[m] = 0;
+
+
+  /*
+   *  single pass over pulse data
+   *  - pulse: fixed spacer or stop pulse
+   *  - pause: variable time for 0/1
+   */
+
+  PulseData += 2;                  /* skip start sequence */
+
+  while ((Pulse < Pulses) && (Live & ~Sealed))
+  {
+    Time = *PulseData;             /* get duration */
+    Set = 0;                       /* reset decision */
+
+    for (m = 0; m < n; m++)        /* process all candidates */
+    {
+      Mask = 1 << m;
+      if (! (Live & Mask)) continue;    /* skip dropped candidate */
+      if (Sealed & Mask) continue;      /* skip finished candidate */
+      Entry = &Cand[m];
+
+      if (Pulse % 2 == 0)          /* pulse */
+      {
+        if (! PulseCheck(Time, Entry->tS, Entry->DataCtrl))
+        {
+          Live &= ~Mask;                /* drop candidate */
+        }
+        else if (Counter == Entry->Bits)     /* stop pulse */
+        {
+          Done |= Mask;                 /* complete packet */
+        }
+      }
+      else                         /* pause */
+      {
+        /* check bit timing */
+        if (PulseCheck(Time, Entry->t0, Entry->DataCtrl))
+        {
+          Bit = 1;                      /* 0 */
+        }
+        else if (PulseCheck(Time, Entry->t1, Entry->DataCtrl))
+        {
+          Bit = 2;                      /* 1 */
+        }
+        else
+        {
+          Bit = 0;                      /* invalid */
+        }
+
+        if (Done & Mask)           /* packet complete, but more data */
+        {
+          /* accept trailing data which isn't part of the packet */
+          if ((Entry->Flags & IR_TAB_TRAILING) && (Bit == 0))
+          {
+            Sealed |= Mask;             /* ignore remaining data */
+          }
+          else
+          {
+            Live &= ~Mask;              /* drop candidate */
+          }
+        }
+        else if (Bit == 0)         /* invalid bit */
+        {
+          Live &= ~Mask;                /* drop candidate */
+        }
+        else if (Set == 0)         /* first decision */
+        {
+          Set = Bit;                    /* set bit for all candidates */
+        }
+        else if (Set != Bit)       /* other decision */
+        {
+          Live &= ~Mask;                /* drop candidate */
+        }
+      }
+    }
+
+    /* save bit */
+    if (Set)
+    {
+      if (Counter < (IR_CODE_BYTES * 8))     /* prevent overflow */
+      {
+        if (Set == 2) IR_Code[Counter / 8] |= (0b10000000 >> (Counter % 8));
+      }
+
+      Counter++;                   /* got another bit */
+    }
+
+    PulseData++;                   /* next one */
+    Pulse++;
+  }
+
+
+  /*
+   *  process result
+   *  - first complete candidate wins
+   */
+
+  Live &= Done;                    /* only complete packets */
+
+  for (m = 0; m < n; m++)
+  {
+    Mask = 1 << m;
+
+    if (Live & Mask)               /* valid packet */
+    {
+      Flag = 2;
+      *Proto = Cand[m];
+      break;
+    }
+
+    if ((Start & Mask) && (Cand[m].Flags & IR_TAB_BAD) && (Flag == 0))
+    {
+      Flag = 1;                    /* bad packet */
+      *Proto = Cand[m];
+      /* keep looking for valid packet */
+    }
+  }
+
+  return Flag;
+}
+
+
+
 /*
  *  detect and decode IR protocol
  *  - uses IR_State to keep track of multi-packet protocols
@@ -782,6 +1023,7 @@ void IR_Decode(uint8_t *PulseData, uint8_t Pulses)
   uint8_t           Command;       /* RC command */
   uint8_t           Extras = 0;    /* RC extra stuff */
   uint8_t           Temp;          /* temporary value */
+  IR_PDM_Type       Proto;         /* protocol data */
 
   /* local constants for Flag */
   #define PROTO_UNKNOWN       0    /* unknown protocol */
@@ -820,6 +1062,7 @@ void IR_Decode(uint8_t *PulseData, uint8_t Pulses)
    *  - repeat sequence:
    *    <pulse 9ms><pause 2.25ms><stop>
    *  - repeat delay is 108ms (start to start)
+   *  - decoded by table, except repeat sequence
    */
 
   /*
@@ -834,50 +1077,12 @@ void IR_Decode(uint8_t *PulseData, uint8_t Pulses)
    *    <start><stop>
    *  - repeat delay is 108ms (start to start) or 23.6ms (end to start)
    *  - carrier 38kHz (455kHz/12), duty cycle 1/3
+   *  - decoded by table
    */
 
   if (PulseCheck(Time1, 179, IR_RELAX_LONG))      /* pulse 9ms */
   {
-    if (PulseCheck(Time2, 89, IR_RELAX_LONG))     /* pause 4.5ms */
-    {
-      /* try to demodulate NEC */
-      Bits = PxM_Demod(Pulse, PulsesLeft, 11, 11, 33, IR_STD_TOLER);
-
-      if (Bits == 32)              /* we expect 32 bits for NEC */
-      {
-        Display_NL_EEString_Space(IR_NEC_str);    /* display protocol */
-
-        Address = GetBits(1, 8, IR_LSB);     /* get address */
-        Extras = GetBits(9, 8, IR_LSB);      /* get inverted address */
-        Command = GetBits(17, 8, IR_LSB);    /* get command */
-
-        /* determine protocol version */
-        Temp = ~Extras;                 /* invert */
-        if (Address != Temp)            /* address is not inverted */
-        {
-          /* extended format with 16 bit address */
-          Display_HexByte(Extras);      /* display high address */
-        }
-
-        Flag = PACKET_DISPLAY;          /* packet ok & default output */
-        goto result;                    /* skip other checks */
-      }
-      #ifdef SW_IR_RX_EXTRA
-      else if (Bits == 42)         /* we expect 42 bits for Sanyo */
-      {
-        Display_NL_EEString_Space(IR_Sanyo_str);  /* display protocol */
-
-        Address = GetBits(1, 8, IR_LSB);     /* get custom code LSB */
-        Extras = GetBits(9, 5, IR_LSB);      /* get custom code MSB */
-        Command = GetBits(27, 8, IR_LSB);    /* get key data */
-
-        Display_HexByte(Extras);        /* display custom code MSB */
-        Flag = PACKET_DISPLAY;          /* packet ok & default output */
-        goto result;                    /* skip other checks */
-      }
-      #endif
-    }
-    else if (PulseCheck(Time2, 45, IR_STD_TOLER))      /* pause 2.25ms */
+    if (PulseCheck(Time2, 45, IR_STD_TOLER))      /* pause 2.25ms */
     {
       /* check for NEC repeat sequence */
       if (Pulses == 3)                       /* just 3 pulses */
@@ -951,29 +1156,9 @@ void IR_Decode(uint8_t *PulseData, uint8_t Pulses)
    *      PDM: pulse 560s, pause 0:600s 1:1620s 
    *    - start: pulse 9ms, pause 4.2ms (180/84)
    *      PDM: pulse 550s, pause 0:550s 1:1580s
+   *  - decoded by table
    */
 
-  if ((PulseCheck(Time1, 168, IR_STD_TOLER)) ||   /* pulse 8.44ms */
-      (PulseCheck(Time1, 184, IR_RELAX_LONG)))    /* 9 - 9.5ms */
-  {
-    if (PulseCheck(Time2, 84, IR_STD_TOLER))      /* pause 4.22ms */
-    {
-      /* try to demodulate JVC */
-      Bits = PxM_Demod(Pulse, PulsesLeft, 11, 11, 32, IR_STD_TOLER);
-
-      if (Bits == 16)              /* we expect 16 bits */
-      {
-        Display_NL_EEString_Space(IR_JVC_str);    /* display protocol */
-
-        Address = GetBits(1, 8, IR_LSB);     /* get address */
-        Command = GetBits(9, 8, IR_LSB);     /* get command */
-
-        Flag = PACKET_DISPLAY;               /* packet ok & default output */
-        goto result;                         /* skip other checks */
-      }
-    }
-  }
-
 
   /*
    *  Matsushita (Panasonic, MN6014)
@@ -1102,50 +1287,11 @@ void IR_Decode(uint8_t *PulseData, uint8_t Pulses)
    *    - PDM: pulse 560s, pause 0:1ms 1:2ms
    *    - repeat delay 10ms (end to start)
    *  - carrier 56kHz or 38.7kHz, duty cycle 1/3
+   *  - packet repeat delay is shorter than sample timeout, so the sample
+   *    data could include a partial second packet (IR_TAB_TRAILING)
+   *  - decoded by table
    */
 
-  #ifdef SW_IR_RX_EXTRA
-  if (PulseCheck(Time1, 79, IR_RELAX_LONG))       /* pulse 4ms */
-  {
-    if (PulseCheck(Time2, 79, IR_RELAX_LONG))     /* pause 4ms */
-    {
-      /*
-       *  Packet repeat delay is shorter than sample timeout. So the sample
-       *  data could include a partial second packet.
-       */
-
-      if (PulsesLeft > 49)         /* more pulses than we need */
-      {
-        /* check for repeat delay */
-        Pulse += 49;               /* 24 bits + stop */
-
-        if (*Pulse >= 158)         /* longer than 7.9ms */
-        {
-          PulsesLeft = 49;         /* hide second packet */
-        } 
-
-        Pulse -=  49;              /* back to second pulse */
-      }
-
-      /* try to demodulate RCA */
-      Bits = PxM_Demod(Pulse, PulsesLeft, 10, 20, 40, IR_RELAX_SHORT);
-
-      if (Bits == 24)              /* we expect 24 bits */
-      {
-        Display_NL_EEString_Space(IR_RCA_str);    /* display protocol */  
-
-        Address = GetBits(1, 4, IR_MSB);     /* get address */
-        Command = GetBits(5, 8, IR_MSB);     /* get command */
-
-        /* todo: check inverted address and command? */
-
-        Flag = PACKET_DISPLAY;               /* packet ok & default output */
-        goto result;                         /* skip other checks */
-      }
-    }
-  }
-  #endif
-
 
   /*
    *  Motorola
@@ -1319,29 +1465,49 @@ void IR_Decode(uint8_t *PulseData, uint8_t Pulses)
    *  - repeat sequence format:
    *    <start><inverted bit #0 of custom><stop>
    *  - repeat delay is 108ms (start to start)
+   *  - decoded by table
    */
 
-  if (PulseCheck(Time1, 89, IR_STD_TOLER))        /* pulse 4.5ms */
+
+  /*
+   *  protocols with start sequence and PDM (IR_PDM_Table)
+   *  - all protocols matching the start sequence are checked in parallel
+   *  - runs at the position of the last table protocol (Samsung) in the
+   *    original check order, so protocols checked before still take
+   *    precedence (e.g. Proton over JVC)
+   *  - the table has to keep the original order as well
+   */
+
+  Temp = IR_PDM_Decode(PulseData, Pulses, &Proto);
+
+  if (Temp > 0)                    /* protocol detected */
   {
-    if (PulseCheck(Time2, 89, IR_STD_TOLER))      /* pause 4.5ms */
+    Display_NL_EEString_Space(Proto.Name);   /* display protocol */
+    Flag = PROTO_DETECTED;                   /* detected protocol */
+
+    if (Temp == 2)                 /* valid packet */
     {
-      Display_NL_EEString_Space(IR_Samsung_str);  /* display protocol */
-      Flag = PROTO_DETECTED;                      /* detected protocol */
+      Temp = IR_LSB;                         /* default: LSB */
+      if (Proto.Flags & IR_TAB_MSB) Temp = IR_MSB;
 
-      /* try to demodulate Samsung */
-      Bits = PxM_Demod(Pulse, PulsesLeft, 11, 11, 34, IR_STD_TOLER);
+      Address = GetBits(Proto.Addr_Pos, Proto.Addr_Len, Temp);  /* get address */
+      Command = GetBits(Proto.Cmd_Pos, Proto.Cmd_Len, Temp);    /* get command */
 
-      if (Bits == 32)              /* we expect 32 bits */
+      if (Proto.Ext_Pos)           /* extra field */
       {
-        Address = GetBits(1, 8, IR_LSB);     /* get address */
-        Command = GetBits(17, 8, IR_LSB);    /* get command */
-        /* todo: check copy of address and inverted command */
+        Extras = GetBits(Proto.Ext_Pos, Proto.Ext_Len, Temp);   /* get extra field */
 
-        Flag = PACKET_DISPLAY;     /* packet ok & default output */
+        /* skip extra field if it's just the inverted address */
+        if (! ((Proto.Flags & IR_TAB_EXT_INV) && (Address == (uint8_t)~Extras)))
+        {
+          Display_HexByte(Extras);           /* display extra field */
+        }
       }
 
-      goto result;                 /* skip other checks */
+      Flag = PACKET_DISPLAY;       /* packet ok & default output */
     }
+
+    goto result;                   /* skip other checks */
   }
 
 
@@ -1761,8 +1927,11 @@ result:
     }
     #endif
 
+    #ifndef SW_IR_RX_CAPTURE
     /* slow down display updates and try to skip early repeats */
     MilliSleep(200);               /* don't proceed too soon */
+    #endif
+    /* input capture: ISR keeps logging, so we process repeats too */
   }
 
   /* clean up local constants */
@@ -1775,6 +1944,275 @@ result:
 
 
 
+#ifdef SW_IR_LEARN
+
+/*
+ *  find nearest symbol (learned IR code)
+ *
+ *  requires:
+ *  - Symbol: pointer to symbol table
+ *  - Symbols: number of symbols
+ *  - Time: duration to look up (in 50s)
+ *
+ *  returns:
+ *  - index of nearest symbol (0 for empty table)
+ */
+
+uint8_t NearestSymbol(uint8_t *Symbol, uint8_t Symbols, uint8_t Time)
+{
+  uint8_t           n = 0;              /* counter */
+  uint8_t           Best = 0;           /* index of nearest symbol */
+  uint8_t           Diff;               /* difference */
+  uint8_t           MinDiff = UINT8_MAX;     /* smallest difference */
+
+  while (n < Symbols)         /* loop through symbols */
+  {
+    /* absolute difference */
+    if (Time > *Symbol) Diff = Time - *Symbol;
+    else Diff = *Symbol - Time;
+
+    if (Diff < MinDiff)       /* nearer than former best */
+    {
+      MinDiff = Diff;         /* update smallest difference */
+      Best = n;               /* and index */
+    }
+
+    Symbol++;                 /* next symbol */
+    n++;
+  }
+
+  return Best;
+}
+
+
+
+/*
+ *  store IR packet as learned code
+ *  - clusters durations of pauses/pulses into a few symbols
+ *  - user selects slot in EEPROM
+ *
+ *  requires:
+ *  - PulseData: pointer to pulse duration data (in 50s)
+ *  - Pulses: number of pauses/pulses
+ */
+
+void IR_Learn(uint8_t *PulseData, uint8_t Pulses)
+{
+  IR_Slot_Type      Slot;                    /* learned code */
+  uint16_t          Sum[IR_SLOT_SYMBOLS];    /* sum of durations */
+  uint8_t           Count[IR_SLOT_SYMBOLS];  /* number of durations */
+  uint8_t           Symbols = 0;        /* number of symbols */
+  uint8_t           n;                  /* counter */
+  uint8_t           m;                  /* symbol index */
+  uint8_t           Time;               /* duration */
+  uint8_t           Diff;               /* difference */
+  uint8_t           Number = 0;         /* slot number */
+
+  if (Pulses > IR_SLOT_PULSES) Pulses = IR_SLOT_PULSES;
+  Slot.Pulses = Pulses;
+
+  for (n = 0; n < IR_SLOT_SYMBOLS; n++) Slot.Symbol[n] = 0;
+
+
+  /*
+   *  cluster durations
+   *  - assign duration to nearest symbol when within tolerance
+   *    (1/8 of symbol + 50s), otherwise create new symbol
+   *  - symbol is mean value of its durations
+   *  - if symbol table is full, use nearest symbol
+   */
+
+  n = 0;
+  while (n < Pulses)          /* loop through pauses/pulses */
+  {
+    Time = PulseData[n];
+    m = NearestSymbol(&Slot.Symbol[0], Symbols, Time);
+
+    if (Symbols > 0)          /* got symbols */
+    {
+      /* absolute difference */
+      if (Time > Slot.Symbol[m]) Diff = Time - Slot.Symbol[m];
+      else Diff = Slot.Symbol[m] - Time;
+
+      if ((Diff > (Slot.Symbol[m] / 8) + 1) && (Symbols < IR_SLOT_SYMBOLS))
+      {
+        m = Symbols;          /* create new symbol */
+      }
+    }
+
+    if (m == Symbols)         /* new symbol */
+    {
+      Sum[m] = 0;
+      Count[m] = 0;
+      Symbols++;
+    }
+
+    /* update symbol */
+    Sum[m] += Time;
+    Count[m]++;
+    Slot.Symbol[m] = (Sum[m] + Count[m] / 2) / Count[m];
+
+    n++;                      /* next one */
+  }
+
+
+  /*
+   *  encode pauses/pulses as symbol indices
+   *  - symbols could have moved while clustering
+   */
+
+  n = 0;
+  while (n < Pulses)          /* loop through pauses/pulses */
+  {
+    m = NearestSymbol(&Slot.Symbol[0], Symbols, PulseData[n]);
+
+    if (n & 1)                /* odd: low nibble */
+    {
+      Slot.Data[n / 2] |= m;
+    }
+    else                      /* even: high nibble */
+    {
+      Slot.Data[n / 2] = m << 4;
+    }
+
+    n++;                      /* next one */
+  }
+
+
+  /*
+   *  select slot and save
+   *  - short key press: next slot
+   *  - long key press: save
+   *  - two short key presses: exit
+   */
+
+  /* wait for key release */
+  while (!(BUTTON_PIN & (1 << TEST_BUTTON))) MilliSleep(50);
+
+  n = 1;
+  while (n)                   /* UI loop */
+  {
+    LCD_ClearLine2();
+    Display_EEString_Space(Save_str);   /* display: Save */
+    Display_Char('0' + Number);         /* display slot number */
+
+    m = TestKey(0, CHECK_KEY_TWICE | CHECK_BAT);
+
+    if (m == KEY_LONG)             /* long key press */
+    {
+      /* write learned code to EEPROM */
+      eeprom_write_block((void *)&Slot, (void *)&NV_IR_Slots[Number], sizeof(IR_Slot_Type));
+
+      Display_Space();
+      Display_EEString(Done_str);       /* display: done! */
+      MilliSleep(1000);                 /* smooth UI */
+      n = 0;                            /* end loop */
+    }
+    else if (m == KEY_TWICE)       /* two short key presses */
+    {
+      n = 0;                            /* end loop */
+    }
+    else if (m == KEY_LEFT)        /* left key */
+    {
+      if (Number > 0) Number--;         /* previous slot */
+      else Number = IR_SLOTS - 1;       /* underflow */
+    }
+    else                           /* short key press or right key */
+    {
+      Number++;                         /* next slot */
+      if (Number >= IR_SLOTS) Number = 0;    /* overflow */
+    }
+  }
+
+  LCD_ClearLine2();
+
+  /* wait for key release */
+  while (!(BUTTON_PIN & (1 << TEST_BUTTON))) MilliSleep(50);
+}
+
+#endif
+
+
+
+#ifdef SW_IR_RX_CAPTURE
+
+/*
+ *  ISR for input capture of Timer1
+ *  - triggered by analog comparator (edge of IR data signal)
+ *  - logs time since last edge into ring buffer (in 50s)
+ *  - a timeout (OCF1A set) marks the start of a new packet
+ *  - after a buffer overflow the next entry marks the lost edges
+ */
+
+ISR(TIMER1_CAPT_vect, ISR_BLOCK)
+{
+  uint16_t          Stamp;         /* timestamp of edge */
+  uint16_t          Duration;      /* time since last edge */
+  uint8_t           Edge;          /* edge type */
+  uint8_t           Next;          /* next write position */
+
+  /*
+   *  hints:
+   *  - the ICF1 interrupt flag is cleared automatically
+   *  - interrupt processing is disabled while this ISR runs
+   *    (no nested interrupts)
+   */
+
+  Stamp = ICR1;                         /* get timestamp */
+  Duration = Stamp - IR_LastEdge;       /* time since last edge */
+  IR_LastEdge = Stamp;                  /* update timestamp */
+
+  /* rising edge of comparator output: start of IR pulse */
+  Edge = TCCR1B & (1 << ICES1);
+  TCCR1B ^= (1 << ICES1);               /* wait for opposite edge */
+  OCR1A = Stamp + IR_TICKS_TIMEOUT;     /* set new timeout */
+
+  if (TIFR1 & (1 << OCF1A))        /* timeout since last edge */
+  {
+    /* a packet has to start with a pulse */
+    if (! Edge)                    /* end of pulse */
+    {
+      /* keep timeout flag and wait for next edge */
+      TIFR1 = (1 << ICF1);              /* clear flag (caused by edge change) */
+      return;
+    }
+
+    Duration = IR_GAP;             /* start of new packet */
+  }
+  else                             /* pulse/pause */
+  {
+    /* convert to time units of 50s (rounded) */
+    Duration += IR_TICKS_50US / 2;
+    Duration /= IR_TICKS_50US;
+    if (Duration >= IR_LOST) Duration = IR_LOST - 1;
+  }
+
+  /* clear flags (edge change may trigger input capture) */
+  TIFR1 = (1 << ICF1) | (1 << OCF1A);
+
+  /* log duration */
+  Next = (IR_Head + 1) & IR_RING_MASK;
+  if (Next != IR_Tail)             /* buffer not full */
+  {
+    if (IR_Overflow)               /* edges lost before */
+    {
+      Duration = IR_LOST;          /* mark lost edges instead */
+      IR_Overflow = 0;             /* reset overflow flag */
+    }
+
+    IR_Ring[IR_Head] = (uint8_t)Duration;    /* save duration */
+    IR_Head = Next;                /* next position */
+  }
+  else                             /* buffer overflow */
+  {
+    IR_Overflow = 1;               /* signal overflow */
+  }
+}
+
+#endif
+
+
+
 /*
  *  detect & decode IR remote control signals
  *  using a TSOP IR receiver module
@@ -1797,13 +2235,20 @@ void IR_Detector(void)
 
   uint8_t           Run = MODE_WAIT;    /* loop control */
   uint8_t           Flag;               /* IR signal */
+  #ifndef SW_IR_RX_CAPTURE
   uint8_t           OldFlag = 0;        /* former IR signal */
   uint8_t           Cycles;             /* delay loop */
+  uint8_t           Period = 0;         /* pulse duration */
+  #else
+  uint8_t           Time;               /* time between edges */
+  #endif
   uint8_t           n;                  /* counter */
   uint8_t           Pulses = 0;         /* pulse counter */
-  uint8_t           Period = 0;         /* pulse duration */
   uint8_t           *Pulse = NULL;      /* pointer to pulse data */
   uint8_t           PulseData[MAX_PULSES];  /* pulse duration data */     
+  #ifdef SW_IR_LEARN
+  uint8_t           Stored = 0;         /* pauses/pulses of complete packet */
+  #endif
 
   ShortCircuit(0);                      /* make sure probes are not shorted */
 
@@ -1943,6 +2388,192 @@ void IR_Detector(void)
   LCD_CharPos(1, 1);               /* move to first line */
 
 
+#ifdef SW_IR_RX_CAPTURE
+
+  /*
+   *  The analog comparator compares the data signal with the bandgap
+   *  reference and triggers Timer1's input capture at each edge. The ISR
+   *  logs the time between edges into a ring buffer while we convert the
+   *  durations into time units of 50s and decode finished packets. So
+   *  sampling continues while decoding, and a pulse/pause exceeding 12ms
+   *  marks the end of a packet.
+   *  - data logic is inverted by IR receiver
+   *    High: no IR signal / pause -> comparator output low
+   *    Low: IR signal / pulse -> comparator output high
+   */
+
+  if (Run)                         /* no key press yet */
+  {
+    /* set up analog comparator */
+    ADCSRA = ADC_CLOCK_DIV;                  /* disable ADC, but keep clock dividers */
+    ADCSRB = (1 << ACME);                    /* use ADC multiplexer as negative input */
+    ACSR = (1 << ACBG) | (1 << ACIC);        /* use bandgap as positive input, trigger Timer1 */
+    ADMUX = ADC_REF_VCC | IR_DATA_PROBE;     /* switch ADC multiplexer to data probe */
+
+    /* reset ring buffer */
+    IR_Head = 0;
+    IR_Tail = 0;
+    IR_Overflow = 0;
+    IR_LastEdge = 0;
+
+    /* set up Timer1: normal mode, noise canceler, rising edge, prescaler 8 */
+    TCCR1A = 0;                              /* normal mode (count up) */
+    TCCR1B = (1 << ICNC1) | (1 << ICES1);    /* timer stopped */
+    TCNT1 = 0;                               /* reset counter */
+    OCR1A = IR_TICKS_50US;                   /* initial timeout */
+    /* clear all flags (input capture, compare A & B, overflow */
+    TIFR1 = (1 << ICF1) | (1 << OCF1B) | (1 << OCF1A) | (1 << TOV1);
+    TCCR1B |= (1 << CS11);                   /* start timer */
+
+    /* wait for initial timeout (signals idle state to ISR) */
+    while (! (TIFR1 & (1 << OCF1A))) ;
+
+    TIFR1 = (1 << ICF1);                     /* clear input capture flag */
+    TIMSK1 = (1 << ICIE1);                   /* enable input capture interrupt */
+  }
+
+  while (Run > 0)             /* processing loop */
+  {
+    /*
+     *  process logged edges
+     */
+
+    while (IR_Tail != IR_Head)          /* got new entries */
+    {
+      Time = IR_Ring[IR_Tail];          /* get duration */
+      IR_Tail = (IR_Tail + 1) & IR_RING_MASK;     /* next position */
+
+      if (Time == IR_GAP)          /* start of new packet */
+      {
+        /* lost edges of previous packet would have shown up as IR_LOST */
+        if (Run == MODE_SAMPLE)         /* previous packet not decoded yet */
+        {
+          IR_Decode(&PulseData[0], Pulses);    /* try to decode */
+        }
+
+        Run = MODE_SAMPLE;              /* start sampling */
+        Pulses = 0;                     /* reset pulse counter */
+        Pulse = &PulseData[0];          /* set start address */
+        #ifdef SW_IR_LEARN
+        Stored = 0;                     /* packet data gets overwritten */
+        #endif
+      }
+      else if (Time == IR_LOST)         /* edges lost (buffer overflow) */
+      {
+        /* skip incomplete packet (and packet with lost start) */
+        Run = MODE_WAIT;                /* ignore pulses/pauses up to next gap */
+      }
+      else if (Run == MODE_SAMPLE)      /* pulse/pause of current packet */
+      {
+        if (Pulses < MAX_PULSES)        /* prevent buffer overflow */
+        {
+          Pulses++;                     /* got another one */
+          *Pulse = Time;                /* save duration */
+          Pulse++;                      /* next one */
+        }
+        else                            /* max number of pulses exceeded */
+        {
+          Run = MODE_DECODE;            /* switch to decoding mode */
+          break;
+        }
+      }
+      /* else: ignore remaining pulses/pauses of packet */
+    }
+
+    /*
+     *  check for end of packet
+     *  - timeout and no pending entries
+     */
+
+    if (Run == MODE_SAMPLE)
+    {
+      cli();                            /* disable interrupts */
+      if ((IR_Tail == IR_Head) && (TIFR1 & (1 << OCF1A)))
+      {
+        Run = MODE_DECODE;              /* switch to decoding mode */
+
+        if (ACSR & (1 << ACO))          /* data pin still low */
+        {
+          /* removed receiver module */
+          Run = MODE_WAIT;              /* skip packet */
+        }
+      }
+      sei();                            /* enable interrupts */
+    }
+
+    /*
+     *  manage tasks
+     */
+
+    if (Run == MODE_DECODE)             /* decoding mode */
+    {
+      /*
+       *  lost edges not marked yet
+       *  - they follow the last logged edge
+       *  - with an empty buffer they belong to this packet
+       */
+
+      n = 1;                            /* default: packet ok */
+      cli();                            /* disable interrupts */
+      if (IR_Overflow && (IR_Tail == IR_Head))
+      {
+        IR_Overflow = 0;                /* reset overflow flag */
+        n = 0;                          /* skip packet */
+      }
+      sei();                            /* enable interrupts */
+
+      if (n)                            /* all edges logged */
+      {
+        IR_Decode(&PulseData[0], Pulses);  /* try to decode */
+        #ifdef SW_IR_LEARN
+        Stored = Pulses;                /* got complete packet */
+        #endif
+      }
+
+      Run = MODE_WAIT;                  /* switch back to waiting mode */
+    }
+
+    /* check test button */
+    #ifdef SW_IR_LEARN
+    if (!(BUTTON_PIN & (1 << TEST_BUTTON)))     /* key pressed */
+    {
+      n = TestKey(0, 0);                /* get type of key press */
+
+      if ((n == KEY_LONG) && (Stored > 0))   /* learn packet */
+      {
+        IR_Learn(&PulseData[0], Stored);
+
+        /* skip edges logged in the meantime */
+        cli();                          /* disable interrupts */
+        IR_Tail = IR_Head;              /* empty ring buffer */
+        IR_Overflow = 0;                /* reset overflow flag */
+        sei();                          /* enable interrupts */
+        Run = MODE_WAIT;                /* ignore rest of current packet */
+      }
+      else                              /* exit */
+      {
+        Run = 0;                        /* end loop */
+      }
+    }
+    #endif
+
+    while (!(BUTTON_PIN & (1 << TEST_BUTTON)))  /* key pressed */
+    {
+      MilliSleep(50);                   /* take a nap */
+      Run = 0;                          /* end loop */
+    }
+
+    wdt_reset();                        /* reset watchdog */
+  }
+
+  /* clean up */
+  TIMSK1 = 0;                           /* disable all interrupts for Timer1 */
+  TCCR1B = 0;                           /* stop timer */
+  ADCSRA = (1 << ADEN) | (1 << ADIF) | ADC_CLOCK_DIV;   /* enable ADC again */
+  ADCSRB &= ~(1 << ACME);               /* disable ADC multiplexer as negative input */
+
+#else
+
   /*
    *  adaptive sampling delay for 10s considering processing loop
    *  - processing loop needs about 24 MCU cycles (3s@8MHz)
@@ -2002,6 +2633,9 @@ void IR_Detector(void)
         Pulses = 0;                /* reset pulse counter */
         Period = 0;                /* reset duration */
         Pulse = &PulseData[0];     /* set start address */
+        #ifdef SW_IR_LEARN
+        Stored = 0;                /* packet data gets overwritten */
+        #endif
       }
       else                    /* no IR signal */
       {
@@ -2066,6 +2700,9 @@ void IR_Detector(void)
     else if (Run == MODE_DECODE)        /* decoding mode */
     {
       IR_Decode(&PulseData[0], Pulses);    /* try to decode */
+      #ifdef SW_IR_LEARN
+      Stored = Pulses;                     /* got complete packet */
+      #endif
       Run = MODE_WAIT;                     /* switch back to waiting mode */
     }
     else if (Run == MODE_KEY)           /* check for test key */
@@ -2073,6 +2710,22 @@ void IR_Detector(void)
       Run = MODE_WAIT;                     /* switch back to waiting mode */
 
       /* check test button */
+      #ifdef SW_IR_LEARN
+      if (!(BUTTON_PIN & (1 << TEST_BUTTON)))  /* key pressed */
+      {
+        n = TestKey(0, 0);                 /* get type of key press */
+
+        if ((n == KEY_LONG) && (Stored > 0))    /* learn packet */
+        {
+          IR_Learn(&PulseData[0], Stored);
+        }
+        else                               /* exit */
+        {
+          Run = 0;                         /* end loop */
+        }
+      }
+      #endif
+
       while (!(BUTTON_PIN & (1 << TEST_BUTTON)))  /* key pressed */
       {
         MilliSleep(50);            /* take a nap */
@@ -2083,6 +2736,8 @@ void IR_Detector(void)
     wdt_reset();                   /* reset watchdog */
   }
 
+#endif
+
   /* clean up local constants */
   #undef MAX_PULSES
 
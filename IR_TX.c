@@ -60,6 +60,14 @@
   #define IR_PROTO_MAX           15     /* number of all protocols */  
 #endif
 
+/* learned code: pseudo protocol after last one */
+#ifdef SW_IR_LEARN
+  #define IR_LEARNED             (IR_PROTO_MAX + 1)   /* raw code */
+  #define IR_ID_MAX              IR_LEARNED           /* last protocol ID */
+#else
+  #define IR_ID_MAX              IR_PROTO_MAX         /* last protocol ID */
+#endif
+
 /* code bit mode */
 #define IR_LSB                    1     /* LSB */
 #define IR_MSB                    2     /* MSB */
@@ -73,6 +81,20 @@
 #define IR_PAUSE         0b00000001     /* pause */
 #define IR_PULSE         0b00000010     /* pulse */
 
+#ifdef SW_IR_TX_TIMER
+/* pulse schedule */
+#define IR_SCHED_SIZE           128     /* max. number of schedule entries */
+#define IR_SYMBOLS               16     /* max. number of durations */
+#define IR_SCHED_MARK    0b10000000     /* entry is pulse (carrier on) */
+#define IR_SCHED_SYMBOL  0b00001111     /* entry's symbol index */
+#define IR_REPEAT_GAP         40000     /* pause before repeated code (s) */
+
+/* transmitter status (bitfield) */
+#define IR_TX_BUSY       0b00000001     /* sending schedule */
+#define IR_TX_REPEAT     0b00000010     /* repeat schedule when done */
+#define IR_TX_OVERFLOW   0b00000100     /* schedule is incomplete */
+#endif
+
 
 /*
  *  local variables
@@ -81,6 +103,232 @@
 /* key toggle feature */
 uint8_t             IR_Toggle = 0;           /* key toggle flag */
 
+#ifdef SW_IR_TX_TIMER
+/* pulse schedule */
+uint8_t             IR_Sched[IR_SCHED_SIZE]; /* entries: type & symbol */
+uint16_t            IR_Symbol[IR_SYMBOLS];   /* durations in carrier periods */
+uint8_t             IR_Entries;              /* number of entries */
+uint8_t             IR_Symbols;              /* number of symbols */
+uint8_t             IR_PendType;             /* type of pending entry */
+uint32_t            IR_Pend;                 /* duration of pending entry */
+
+/* ISR */
+volatile uint8_t    IR_Pos;                  /* current entry */
+volatile uint16_t   IR_Periods;              /* periods left of entry */
+volatile uint8_t    IR_Runs;                 /* runs of schedule */
+volatile uint8_t    IR_TX_Flags = 0;         /* transmitter status */
+#endif
+
+
+
+#ifdef SW_IR_TX_TIMER
+
+/* ************************************************************************
+ *   timer-driven transmission
+ * ************************************************************************ */
+
+
+/*
+ *  clear pulse schedule
+ */
+
+void IR_Sched_Reset(void)
+{
+  IR_Entries = 0;                       /* no entries */
+  IR_Symbols = 0;                       /* no symbols */
+  IR_PendType = 0;                      /* no pending entry */
+  IR_Pend = 0;
+  IR_Runs = 1;                          /* send schedule once */
+  IR_TX_Flags = 0;                      /* reset status */
+}
+
+
+
+/*
+ *  move pending entry to pulse schedule
+ *  - looks up duration in symbol table and adds it if not found
+ */
+
+void IR_Sched_Flush(void)
+{
+  uint8_t           n;                  /* symbol index */
+  uint16_t          Periods;            /* duration in carrier periods */
+
+  if (IR_Pend == 0) return;             /* nothing pending */
+
+  /* limit duration to 16 bits (about 1s) */
+  if (IR_Pend > UINT16_MAX) Periods = UINT16_MAX;
+  else Periods = (uint16_t)IR_Pend;
+
+  /* search symbol table */
+  n = 0;
+  while (n < IR_Symbols)                /* loop through known symbols */
+  {
+    if (IR_Symbol[n] == Periods) break; /* match */
+    n++;                                /* next one */
+  }
+
+  if (n == IR_Symbols)                  /* new symbol */
+  {
+    if (n < IR_SYMBOLS)                 /* free slot */
+    {
+      IR_Symbol[n] = Periods;           /* add symbol */
+      IR_Symbols++;
+    }
+    else                                /* table full */
+    {
+      IR_TX_Flags |= IR_TX_OVERFLOW;    /* signal error */
+    }
+  }
+
+  if (IR_Entries < IR_SCHED_SIZE)       /* free entry */
+  {
+    if (IR_PendType & IR_PULSE) n |= IR_SCHED_MARK;  /* pulse */
+    IR_Sched[IR_Entries] = n;           /* add entry */
+    IR_Entries++;
+  }
+  else                                  /* schedule full */
+  {
+    IR_TX_Flags |= IR_TX_OVERFLOW;      /* signal error */
+  }
+
+  IR_Pend = 0;                          /* entry done */
+}
+
+
+
+/*
+ *  add pause/pulse to pulse schedule
+ *  - converts time into carrier periods
+ *  - merges consecutive pauses or pulses into a single entry
+ *  - carrier frequency has to be set before (OCR1A)
+ *
+ *  requires:
+ *  - type: IR_PAUSE or IR_PULSE
+ *  - time: duration in s
+ */
+
+void IR_Sched_Add(uint8_t Type, uint16_t Time)
+{
+  uint32_t          Periods;            /* carrier periods */
+  uint16_t          Cycles;             /* MCU cycles per carrier period */
+
+  Type &= IR_PULSE;                     /* normalize type (bi-phase) */
+  if (Type == 0) Type = IR_PAUSE;
+
+  /* periods = time * MCU cycles per s / cycles per period (rounded) */
+  Cycles = OCR1A + 1;                   /* top + 1 */
+  Periods = Time;
+  Periods *= MCU_CYCLES_PER_US;         /* MCU cycles */
+  Periods += Cycles / 2;                /* for rounding */
+  Periods /= Cycles;                    /* carrier periods */
+  if (Periods == 0) Periods = 1;        /* at least one period */
+
+  if (Type != IR_PendType)              /* type changes */
+  {
+    IR_Sched_Flush();                   /* commit pending entry */
+    IR_PendType = Type;                 /* start new entry */
+  }
+
+  IR_Pend += Periods;                   /* add duration */
+}
+
+
+
+/*
+ *  start sending pulse schedule
+ *  - carrier frequency and duty cycle have to be set before
+ *  - Timer1 has to be in fast PWM mode with OCR1A as top
+ *
+ *  returns:
+ *  - 1 on success
+ *  - 0 on error (incomplete schedule)
+ */
+
+uint8_t IR_Send_Start(void)
+{
+  IR_Sched_Flush();                     /* commit pending entry */
+
+  if (IR_TX_Flags & IR_TX_OVERFLOW) return 0;     /* incomplete */
+  if (IR_Entries == 0) return 0;                  /* empty */
+
+  IR_Pos = 0;                           /* first entry */
+  IR_Periods = 1;                       /* load entry with first overflow */
+  IR_TX_Flags |= IR_TX_BUSY;            /* we are busy */
+
+  /* carrier off: disable OC1B */
+  TCCR1A = (1 << WGM11) | (1 << WGM10);
+  TCNT1 = 0;                            /* set counter to 0 */
+  TIFR1 = (1 << TOV1);                  /* clear overflow flag */
+  TIMSK1 = (1 << TOIE1);                /* enable overflow interrupt */
+
+  /* start Timer1 by setting prescaler 1:1 */
+  TCCR1B = (1 << WGM13) | (1 << WGM12) | (1 << CS10);
+
+  return 1;
+}
+
+
+
+/*
+ *  ISR for overflow of Timer1 (carrier period)
+ *  - gates carrier based on pulse schedule
+ */
+
+ISR(TIMER1_OVF_vect, ISR_BLOCK)
+{
+  uint8_t           Entry;              /* schedule entry */
+
+  /*
+   *  hints:
+   *  - the TOV1 interrupt flag is cleared automatically
+   *  - in fast PWM mode the overflow is triggered at top (OCR1A),
+   *    i.e. once per carrier period
+   *  - OC1B runs inverted (cleared at bottom, set at OCR1B match)
+   *    so that the output is low when we change COM1B and every
+   *    pulse starts and ends with a complete carrier period
+   *  - interrupt is disabled automatically while running this ISR
+   */
+
+  IR_Periods--;                         /* another period done */
+  if (IR_Periods > 0) return;           /* entry not finished yet */
+
+  if (IR_Pos >= IR_Entries)             /* end of schedule */
+  {
+    if (IR_Runs > 1)                    /* more runs */
+    {
+      IR_Runs--;                        /* another run done */
+    }
+    else if (! (IR_TX_Flags & IR_TX_REPEAT))   /* done */
+    {
+      TCCR1B = (1 << WGM13) | (1 << WGM12);    /* stop Timer1 */
+      TIMSK1 = 0;                       /* disable interrupt */
+      IR_TX_Flags &= ~IR_TX_BUSY;       /* not busy anymore */
+      return;
+    }
+
+    IR_Pos = 0;                         /* start again */
+  }
+
+  /* load next entry */
+  Entry = IR_Sched[IR_Pos];
+  IR_Pos++;
+  IR_Periods = IR_Symbol[Entry & IR_SCHED_SYMBOL];
+
+  if (Entry & IR_SCHED_MARK)            /* pulse */
+  {
+    /* carrier on: enable inverted OC1B */
+    TCCR1A = (1 << WGM11) | (1 << WGM10) | (1 << COM1B1) | (1 << COM1B0);
+  }
+  else                                  /* pause */
+  {
+    /* carrier off: disable OC1B */
+    TCCR1A = (1 << WGM11) | (1 << WGM10);
+  }
+}
+
+#endif
+
 
 
 /* ************************************************************************
@@ -91,6 +339,7 @@ uint8_t             IR_Toggle = 0;           /* key toggle flag */
 
 /*
  *  send single pause/pulse
+ *  - with SW_IR_TX_TIMER the pause/pulse is added to the pulse schedule
  *
  *  requires:
  *  - type: IR_PAUSE or IR_PULSE
@@ -99,6 +348,12 @@ uint8_t             IR_Toggle = 0;           /* key toggle flag */
 
 void IR_Send_Pulse(uint8_t Type, uint16_t Time)
 {
+  #ifdef SW_IR_TX_TIMER
+
+  IR_Sched_Add(Type, Time);        /* add to schedule */
+
+  #else
+
   if (Type & IR_PULSE)        /* create pulse */
   {
     /* enable output via OC1B pin */
@@ -204,6 +459,37 @@ void IR_Send_Pulse(uint8_t Type, uint16_t Time)
     /* disable output via OC1B pin */
     TCCR1A = (1 << WGM11) | (1 << WGM10);
   }
+
+  #endif
+}
+
+
+
+/*
+ *  delay between packets
+ *  - with SW_IR_TX_TIMER the delay is added to the pulse schedule
+ *
+ *  requires:
+ *  - time: delay in ms
+ */
+
+void IR_Send_Delay(uint8_t Time)
+{
+  #ifdef SW_IR_TX_TIMER
+
+  while (Time > 50)           /* 50ms chunks (s based) */
+  {
+    IR_Sched_Add(IR_PAUSE, 50000);      /* merged into single pause */
+    Time -= 50;
+  }
+
+  IR_Sched_Add(IR_PAUSE, Time * 1000U);
+
+  #else
+
+  MilliSleep(Time);
+
+  #endif
 }
 
 
@@ -553,6 +839,49 @@ void PutBits(uint16_t Data, uint8_t Bits, uint8_t StartBit, uint8_t Mode)
 
 
 
+#ifdef SW_IR_LEARN
+
+/*
+ *  send learned IR code (raw)
+ *  - pauses/pulses stored in EEPROM by IR detector
+ *
+ *  requires:
+ *  - Number: slot number
+ */
+
+void IR_Send_Raw(uint8_t Number)
+{
+  IR_Slot_Type      Slot;               /* learned code */
+  uint8_t           n = 0;              /* counter */
+  uint8_t           Symbol;             /* symbol index */
+  uint8_t           Type = IR_PULSE;    /* signal type */
+  uint16_t          Time;               /* duration */
+
+  /* read slot from EEPROM */
+  eeprom_read_block((void *)&Slot, (void *)&NV_IR_Slots[Number], sizeof(IR_Slot_Type));
+
+  if (Slot.Pulses > IR_SLOT_PULSES) return;    /* erased EEPROM */
+
+  while (n < Slot.Pulses)     /* loop through pauses/pulses */
+  {
+    /* get symbol index (4 bits, first one in high nibble) */
+    Symbol = Slot.Data[n / 2];
+    if (! (n & 1)) Symbol >>= 4;
+    Symbol &= (IR_SLOT_SYMBOLS - 1);
+
+    Time = Slot.Symbol[Symbol];         /* duration in 50s */
+    Time *= 50;                         /* in s */
+    IR_Send_Pulse(Type, Time);
+
+    Type ^= IR_PULSE | IR_PAUSE;        /* alternate pulse and pause */
+    n++;                                /* next one */
+  }
+}
+
+#endif
+
+
+
 /*
  *  send IR code
  *
@@ -566,6 +895,9 @@ void IR_Send_Code(uint8_t Proto, uint16_t *Data)
   uint16_t          Temp;          /* temporary value */
   uint8_t           n;             /* counter */
 
+  #ifdef SW_IR_TX_TIMER
+  IR_Sched_Reset();                /* start new schedule */
+  #endif
 
   /*
    *  JVC C8D8
@@ -641,7 +973,12 @@ void IR_Send_Code(uint8_t Proto, uint16_t *Data)
     PutBits(n, 8, 41, IR_LSB);          /* check, 8 bits */
 
     /* send code three times */
+    #ifdef SW_IR_TX_TIMER
+    IR_Runs = 3;              /* ISR repeats schedule */
+    n = 1;                    /* schedule packet once */
+    #else
     n = 3;
+    #endif
 
     while (n > 0)
     {
@@ -649,7 +986,7 @@ void IR_Send_Code(uint8_t Proto, uint16_t *Data)
       IR_Send_Pulse(IR_PAUSE, 1728);
       IR_Send_PDM(&IR_Code[0], 48, 432, 432, 1296);
 
-      MilliSleep(74);         /* delay for next packet */
+      IR_Send_Delay(74);      /* delay for next packet */
 
       n--;                    /* next run */
     }
@@ -721,9 +1058,9 @@ void IR_Send_Code(uint8_t Proto, uint16_t *Data)
     IR_Send_Pulse(IR_PULSE, 512);       /* start */
     IR_Send_Pulse(IR_PAUSE, 2560);
     IR_Send_BiPhase(&IR_Code[2], 10, IR_THOMAS, 512);  /* start packet */
-    MilliSleep(118);                                   /* delay */
+    IR_Send_Delay(118);                                /* delay */
     IR_Send_BiPhase(&IR_Code[0], 10, IR_THOMAS, 512);  /* command packet */
-    MilliSleep(118);                                   /* delay */
+    IR_Send_Delay(118);                                /* delay */
     IR_Send_BiPhase(&IR_Code[2], 10, IR_THOMAS, 512);  /* end packet */ 
   }
 
@@ -971,7 +1308,7 @@ void IR_Send_Code(uint8_t Proto, uint16_t *Data)
 
     /* send code */
     IR_Send_PDM(&IR_Code[0], 15, 264, 786, 1836);      /* packet #1 */
-    MilliSleep(40);                                    /* delay */
+    IR_Send_Delay(40);                                 /* delay */
     IR_Send_PDM(&IR_Code[2], 15, 264, 786, 1836);      /* packet #2 */
   }
 
@@ -1001,7 +1338,12 @@ void IR_Send_Code(uint8_t Proto, uint16_t *Data)
     Temp -= CodeTime(&IR_Code[0], 12, 600, 600, 1200);
 
     /* send code three times */
+    #ifdef SW_IR_TX_TIMER
+    IR_Runs = 3;              /* ISR repeats schedule */
+    n = 1;                    /* schedule packet once */
+    #else
     n = 3;
+    #endif
     while (n > 0)
     {
       IR_Send_Pulse(IR_PULSE, 2400);    /* start */
@@ -1038,7 +1380,12 @@ void IR_Send_Code(uint8_t Proto, uint16_t *Data)
     Temp -= CodeTime(&IR_Code[0], 15, 600, 600, 1200);
 
     /* send code three times */
+    #ifdef SW_IR_TX_TIMER
+    IR_Runs = 3;              /* ISR repeats schedule */
+    n = 1;                    /* schedule packet once */
+    #else
     n = 3;
+    #endif
     while (n > 0)
     {
       IR_Send_Pulse(IR_PULSE, 2400);    /* start */
@@ -1079,7 +1426,12 @@ void IR_Send_Code(uint8_t Proto, uint16_t *Data)
     Temp -= CodeTime(&IR_Code[0], 20, 600, 600, 1200);
 
     /* send code three times */
+    #ifdef SW_IR_TX_TIMER
+    IR_Runs = 3;              /* ISR repeats schedule */
+    n = 1;                    /* schedule packet once */
+    #else
     n = 3;
+    #endif
     while (n > 0)
     {
       IR_Send_Pulse(IR_PULSE, 2400);    /* start */
@@ -1124,7 +1476,12 @@ void IR_Send_Code(uint8_t Proto, uint16_t *Data)
     Temp *= 2;                          /* double for real time */
 
     /* send code two times */
+    #ifdef SW_IR_TX_TIMER
+    IR_Runs = 2;              /* ISR repeats schedule */
+    n = 1;                    /* schedule packet once */
+    #else
     n = 2;
+    #endif
     while (n > 0)
     {
       IR_Send_PDM(&IR_Code[0], 12, 500, 2000, 4500);
@@ -1136,6 +1493,29 @@ void IR_Send_Code(uint8_t Proto, uint16_t *Data)
   #endif
 
 
+  #ifdef SW_IR_LEARN
+  /*
+   *  learned code (raw)
+   *  - pauses/pulses as captured by IR detector
+   *  - Data #0: slot number
+   */
+
+  else if (Proto == IR_LEARNED)         /* learned code */
+  {
+    IR_Send_Raw((uint8_t)*Data);
+  }
+  #endif
+
+
+  #ifdef SW_IR_TX_TIMER
+  /* pause before repeating code */
+  if (IR_PendType & IR_PULSE)      /* schedule ends with pulse */
+  {
+    IR_Sched_Add(IR_PAUSE, IR_REPEAT_GAP);
+  }
+  #endif
+
+
   #if 0
   /* debugging */
   LCD_ClearLine(6);
@@ -1412,6 +1792,16 @@ void IR_RemoteControl(void)
           DutyCycle = 3;           /* 1/3 */
           break;
         #endif
+
+        #ifdef SW_IR_LEARN
+        case IR_LEARNED:           /* learned code */
+          ProtoStr = (unsigned char *)IR_Raw_str;
+          Bits[0] = IR_SLOT_BITS;  /* slot number */
+          Fields = 1;              /* 1 data field */
+          Carrier = 38;            /* unknown, most common one */
+          DutyCycle = 3;           /* 1/3 */
+          break;
+        #endif
       }
 
       /* reset data fields */
@@ -1455,7 +1845,12 @@ void IR_RemoteControl(void)
 
       /* update Timer1 */
       OCR1A = Temp;                     /* top value for frequency */
+      #ifdef SW_IR_TX_TIMER
+      /* OC1B is inverted: pulse from OCR1B to top */
+      Temp -= Temp / DutyCycle;         /* apply duty cycle */
+      #else
       Temp /= DutyCycle;                /* apply duty cycle */
+      #endif
       OCR1B = Temp;                     /* top value for duty cycle */
 
       Flag &= ~UPDATE_FREQ;             /* clear flag */
@@ -1538,7 +1933,7 @@ void IR_RemoteControl(void)
       if (Mode == MODE_PROTO)           /* protocol mode */
       {
         Proto_ID++;                     /* next one */
-        if (Proto_ID > IR_PROTO_MAX)    /* overflow */
+        if (Proto_ID > IR_ID_MAX)       /* overflow */
         {
           Proto_ID = 1;                 /* reset to first one */
         }
@@ -1587,7 +1982,7 @@ void IR_RemoteControl(void)
         Proto_ID--;                     /* previous one */
         if (Proto_ID == 0)              /* underflow */
         {
-          Proto_ID = IR_PROTO_MAX;      /* reset to last one */
+          Proto_ID = IR_ID_MAX;         /* reset to last one */
         }
 
         Flag |= CHANGE_PROTO | DISPLAY_PROTO | DISPLAY_DATA;
@@ -1637,6 +2032,39 @@ void IR_RemoteControl(void)
 
     if (Flag & SEND_CODE)     /* send IR code */
     {
+      #ifdef SW_IR_TX_TIMER
+
+      /* build schedule and start sending */
+      IR_Send_Code(Proto_ID, &Data[0]);
+      IR_TX_Flags |= IR_TX_REPEAT;      /* repeat while key is pressed */
+
+      if (IR_Send_Start())              /* sending */
+      {
+        LCD_CharPos(1, 5);              /* line #5 */
+        Display_EEString(IR_Send_str);  /* display: sending... */
+
+        while (IR_TX_Flags & IR_TX_BUSY)     /* ISR is sending */
+        {
+          wdt_reset();                  /* reset watchdog */
+
+          if (BUTTON_PIN & (1 << TEST_BUTTON))    /* key released */
+          {
+            cli();                      /* disable interrupts */
+            IR_TX_Flags &= ~IR_TX_REPEAT;    /* stop repeating */
+            sei();                      /* enable interrupts */
+          }
+
+          MilliSleep(10);               /* take a short nap */
+        }
+
+        LCD_ClearLine(5);               /* clear line #5 */
+      }
+
+      /* key is released, so next code is a new key press */
+      IR_Toggle ^= 0b00000001;          /* toggle flag */
+
+      #else
+
       n = 1;
 
       while (n > 0)                /* send/repeat */
@@ -1663,12 +2091,17 @@ void IR_RemoteControl(void)
         MilliSleep(200);           /* take a short nap */
       }
 
+      #endif
+
       Flag &= ~SEND_CODE;          /* clear flag */
     }
   }
 
 
   /* clean up */
+  #ifdef SW_IR_TX_TIMER
+  TIMSK1 = 0;                 /* disable interrupts */
+  #endif
   TCCR1B = 0;                 /* disable timer */
   TCCR1A = 0;                 /* reset flags (also frees PB2) */
 
@@ -129,6 +129,9 @@ uint16_t MeasureESR(Capacitor_Type *Cap)
   uint32_t          Sum_1;         /* sum #1 */
   uint32_t          Sum_2;         /* sum #2 */
   uint32_t          Value;
+  #ifdef SW_ESR_GATETIME
+  uint16_t          Gate;          /* gate time (Timer1 ticks) */
+  #endif
 
   /* check for a capacitor >= 10nF */
   if ((Cap == NULL) ||
@@ -224,9 +227,28 @@ uint16_t MeasureESR(Capacitor_Type *Cap)
 
   U_2 = 50;              /* don't start with positive half-pulse */
   U_4 = 0;               /* start with a negative half-pulse */
+
+  #ifdef SW_ESR_GATETIME
+  /*
+   *  averaging over a fixed gate time
+   *  - same pulses and sampling as below, the loop just keeps summing
+   *    up the differences until the gate time is over
+   *  - a gate time of a multiple of 100ms covers whole periods of
+   *    50/60Hz hum, which reduces its influence
+   *  - gate timer: Timer1, prescaler 1024
+   */
+
+  Gate = (CPU_FREQ / 10240) * Cfg.ESR_Gate;     /* gate time */
+  TCCR1A = 0;                      /* normal mode */
+  TCNT1 = 0;                       /* reset counter */
+  TCCR1B = (1 << CS12) | (1 << CS10);     /* start timer, prescaler 1024 */
+
+  while (TCNT1 < Gate)
+  #else
   n = 255;               /* set loop counter */
 
   while (n > 0)
+  #endif
   {
     wdt_reset();                   /* reset watchdog */
 
@@ -363,9 +385,15 @@ uint16_t MeasureESR(Capacitor_Type *Cap)
     Sum_1 += U_3;        /* negative pulse without DUT */
     Sum_2 += U_2;        /* positive pulse with DUT */
     Sum_2 += U_4;        /* negative pulse with DUT */
+    #ifndef SW_ESR_GATETIME
     n--;                 /* next loop run */
+    #endif
   }
 
+  #ifdef SW_ESR_GATETIME
+  TCCR1B = 0;                      /* stop timer */
+  #endif
+
   /* probes: reset to safe mode */
   ADC_DDR = 0;
   R_PORT = 0;
@@ -391,6 +419,15 @@ uint16_t MeasureESR(Capacitor_Type *Cap)
     /* voltage across the DUT (raw value) */
     Sum_2 -= Sum_1;           /* subtract voltage at DUT's low side (RiL) */
 
+    #ifdef SW_ESR_GATETIME
+    /* scale down sums to prevent overflow of RiL * Sum_2 */
+    while ((Sum_2 > 0xFFFFF) && (Sum_1 > 1))
+    {
+      Sum_1 >>= 1;
+      Sum_2 >>= 1;
+    }
+    #endif
+
     /* ESR = Sum_2 * RiL / Sum_1 */
     Value = (uint32_t)(NV.RiL * 10);    /* RiL in 0.01 Ohms */
     Value *= Sum_2;                     /* sum of raw values for voltage across DUT */
@@ -534,6 +571,9 @@ uint16_t MeasureESR(Capacitor_Type *Cap)
   uint32_t          Sum_1;         /* sum #1 */
   uint32_t          Sum_2;         /* sum #2 */
   uint32_t          Value;
+  #ifdef SW_ESR_GATETIME
+  uint16_t          Gate;          /* gate time (Timer1 ticks) */
+  #endif
 
   /* check for a capacitor >= 0.18F */
   if ((Cap == NULL) ||
@@ -612,8 +652,18 @@ uint16_t MeasureESR(Capacitor_Type *Cap)
    *  - measure pulse voltage (with load)
    */  
 
+  #ifdef SW_ESR_GATETIME
+  /* averaging over a fixed gate time (see above) */
+  Gate = (CPU_FREQ / 10240) * Cfg.ESR_Gate;     /* gate time */
+  TCCR1A = 0;                      /* normal mode */
+  TCNT1 = 0;                       /* reset counter */
+  TCCR1B = (1 << CS12) | (1 << CS10);     /* start timer, prescaler 1024 */
+
+  while (TCNT1 < Gate)
+  #else
   n = 255;
   while (n > 0)
+  #endif
   {
     /*
      *  forward mode, probe-1 only (probe-2 in HiZ mode)
@@ -750,9 +800,15 @@ uint16_t MeasureESR(Capacitor_Type *Cap)
     U_2 += U_4;          /* sum of both measurements with pulses/load */
     Sum_2 += U_2;        /* add to total with-load sum */
 
+    #ifndef SW_ESR_GATETIME
     n--;                 /* next loop run */
+    #endif
   }
 
+  #ifdef SW_ESR_GATETIME
+  TCCR1B = 0;                      /* stop timer */
+  #endif
+
 
   /*
    *  process measurements
@@ -768,6 +824,15 @@ uint16_t MeasureESR(Capacitor_Type *Cap)
     Sum_2 = 0;
   }
 
+  #ifdef SW_ESR_GATETIME
+  /* scale down sums to prevent overflow of RiL * Sum_2 */
+  while ((Sum_2 > 0xFFFFF) && (Sum_1 > 1))
+  {
+    Sum_1 >>= 1;
+    Sum_2 >>= 1;
+  }
+  #endif
+
 
   /*
    *  calculate ESR
@@ -865,6 +930,435 @@ Small caps:
 */
 
 
+#ifdef SW_C_FIT
+
+/*
+ *  measure cap >4.7F between two probe pins by curve fitting
+ *  - charge DUT via Rl and sample voltage at fixed intervals using
+ *    transient capture (ADC auto-triggered by Timer1)
+ *  - the charge is the integral of the current through Rl and probe
+ *    resistor (trapezoid rule), so the exponential charging curve is
+ *    linearized: U = U_0 + Q/C' + U_ESR
+ *  - least-squares fit of U vs. Q gives C (slope) and ESR (intercept)
+ *  - sampling interval is doubled (and the buffer decimated) when
+ *    the buffer is full before the target voltage is reached
+ *  - leakage is derived from a least-squares fit of the self-discharge
+ *    after charging
+ *  - uses bandgap reference for all samples (ratiometric to Vcc)
+ *
+ *  requires:
+ *  - Cap: pointer to capacitor data structure
+ *
+ *  returns:
+ *  - 3 on success
+ *  - 1 if capacitance is too high
+ *  - 0 on any problem (caller falls back to pulse method)
+ */
+
+uint8_t LargeCapFit(Capacitor_Type *Cap)
+{
+  uint8_t           Flag = 3;      /* return value */
+  uint8_t           n;             /* number of samples */
+  uint8_t           i;             /* counter */
+  uint8_t           Shift;         /* scaling of charge */
+  int8_t            Scale;         /* capacitance scale */
+  uint16_t          Ticks;         /* sampling interval (timer ticks) */
+  uint16_t          U_ref;         /* Vcc in ADC counts (bandgap ref) */
+  uint16_t          U_max;         /* target voltage in ADC counts */
+  uint16_t          Buffer[FIT_SAMPLES + 1];    /* ADC samples */
+  uint16_t          R_Total;       /* charging resistance (0.1 Ohms) */
+  uint16_t          R_s;           /* series resistance (0.01 Ohms) */
+  int16_t           X, Y;          /* centered sample */
+  int32_t           S_x, S_y;      /* sums / means */
+  int32_t           S_xx, S_xy;    /* sums of squares and products */
+  uint32_t          Q;             /* charge */
+  uint32_t          Value;         /* temp. value */
+
+  /* local constants */
+  #define FIT_TICKS_MIN    ((200UL * MCU_CYCLES_PER_US) / 64)     /* 200s */
+  #define FIT_TICKS_MAX    ((65000UL * MCU_CYCLES_PER_US) / 64)   /* 65ms */
+  #define FIT_TICKS_HOLD   ((4000UL * MCU_CYCLES_PER_US) / 64)    /* 4ms */
+  #define FIT_HOLD         32        /* samples for self-discharge */
+
+
+  /*
+   *  init
+   */
+
+  /* prepare probes */
+  DischargeProbes();                    /* try to discharge probes */
+  if (Check.Found == COMP_ERROR) return 0;     /* skip on error */
+
+  /* Vcc and target voltage (1000mV) in ADC counts of bandgap reference */
+  Value = Cfg.Vcc;
+  Value *= 1024;
+  Value /= Cfg.Bandgap;
+  U_ref = (uint16_t)Value;
+  Value = 1000UL * 1024;
+  Value /= Cfg.Bandgap;
+  U_max = (uint16_t)Value;
+
+  /* charging resistance: Rl + RiH (in 0.1 Ohms) */
+  R_Total = (R_LOW * 10) + NV.RiH;
+
+  /* set probes: Gnd -- probe-2 / probe-1 -- HiZ */
+  ADC_PORT = 0;                    /* set ADC port to low */
+  ADC_DDR = Probes.Pin_2;          /* pull down probe-2 directly */
+  R_PORT = 0;                      /* set resistor port to low */
+  R_DDR = 0;                       /* set resistor port to HiZ */
+
+  /* get start voltage (4 samples, bandgap reference) */
+  Ticks = FIT_TICKS_MIN;                /* start with shortest interval */
+  ADC_CaptureStart(Probes.Ch_1, ADC_REF_BANDGAP, Ticks);
+  ADC_Capture(Buffer, 4);
+  Buffer[0] = (Buffer[0] + Buffer[1] + Buffer[2] + Buffer[3]) / 4;
+
+
+  /*
+   *  charge DUT and sample voltage
+   *  - probe-1 -- Rl -- Vcc
+   */
+
+  R_PORT = Probes.Rl_1;            /* pull up probe-1 via Rl */
+  R_DDR = Probes.Rl_1;             /* enable pull-up */
+  ADC_CaptureStart(Probes.Ch_1, ADC_REF_BANDGAP, Ticks);   /* restart */
+
+  n = 1;                           /* first sample is start voltage */
+  while (n)                        /* sampling loop */
+  {
+    Buffer[n] = ADC_CaptureSample();    /* wait for and save sample */
+    n++;                           /* next sample */
+
+    if (Buffer[n - 1] >= U_max)    /* target voltage reached */
+    {
+      break;                       /* end loop */
+    }
+
+    if (n > FIT_SAMPLES)           /* buffer full */
+    {
+      if (Ticks > (FIT_TICKS_MAX / 2))  /* longest interval reached */
+      {
+        break;                     /* end loop */
+      }
+
+      /* double interval and keep every second sample */
+      Ticks *= 2;
+      ADC_CaptureInterval(Ticks);
+
+      i = 0;
+      while (i <= (FIT_SAMPLES / 2))
+      {
+        Buffer[i] = Buffer[2 * i];
+        i++;
+      }
+      n = (FIT_SAMPLES / 2) + 1;
+    }
+
+    wdt_reset();                   /* reset watchdog */
+  }
+
+  /* stop charging: probe-1 -- HiZ */
+  R_DDR = 0;                       /* set resistor port to HiZ */
+  R_PORT = 0;                      /* set resistor port to low */
+
+
+  /*
+   *  check results
+   */
+
+  if (n < 9)                       /* too few samples: small cap */
+  {
+    Flag = 0;                      /* let pulse method handle it */
+  }
+  else if ((int16_t)(Buffer[n - 1] - Buffer[1]) < 10)  /* hardly any change */
+  {
+    Flag = 1;                      /* signal too high capacitance */
+  }
+
+
+  /*
+   *  least-squares fit of voltage vs. charge
+   *  - charge in units of ADC counts * Ticks / 2 (trapezoid rule)
+   *  - the start voltage is just the baseline, since the voltage across
+   *    the ESR is missing, i.e. the first interval uses the current of
+   *    the first sample only and the fit starts with the first sample
+   *  - scale charge down to 12 bits to prevent overflows
+   */
+
+  if (Flag == 3)
+  {
+    /* get maximum charge and scaling */
+    Q = 0;
+    i = 1;
+    while (i < n)
+    {
+      Q += (2 * U_ref) - Buffer[i - 1 + (i == 1)] - Buffer[i];
+      i++;
+    }
+
+    Shift = 0;
+    while (Q > 4095)
+    {
+      Q >>= 1;
+      Shift++;
+    }
+
+    /* get means (X and Y) */
+    S_x = 0;
+    S_y = 0;
+    Q = 0;
+    i = 1;
+    while (i < n)
+    {
+      Q += (2 * U_ref) - Buffer[i - 1 + (i == 1)] - Buffer[i];
+      S_x += Q >> Shift;
+      S_y += Buffer[i] - Buffer[0];
+      i++;
+    }
+    n--;                           /* number of samples fitted */
+    S_x *= 16;                     /* mean in 1/16 */
+    S_x /= n;
+    S_y *= 16;
+    S_y /= n;
+    n++;
+
+    /* get centered sums */
+    S_xx = 0;
+    S_xy = 0;
+    Q = 0;
+    i = 1;
+    while (i < n)
+    {
+      Q += (2 * U_ref) - Buffer[i - 1 + (i == 1)] - Buffer[i];
+      X = (Q >> Shift) - (S_x / 16);
+      Y = (Buffer[i] - Buffer[0]) - (S_y / 16);
+      S_xx += (int32_t)X * X;
+      S_xy += (int32_t)X * Y;
+      i++;
+    }
+
+    /* sanity check: voltage has to rise with charge */
+    if (S_xy <= 0) Flag = 0;
+  }
+
+  if (Flag == 3)
+  {
+    /* scale down to 16 bits */
+    while (S_xx > UINT16_MAX)
+    {
+      S_xx >>= 1;
+      S_xy >>= 1;
+    }
+    if (S_xy == 0) S_xy = 1;       /* prevent division by zero */
+
+
+    /*
+     *  series resistance (ESR + RiL) from intercept
+     *  - intercept: U_s = U_x - slope * Q_x  (in 1/16 ADC counts)
+     *  - R_s = R_total * U_s / (U_ref - U_0 - U_s)
+     */
+
+    Value = (uint32_t)S_xy;
+    Value *= S_x;                  /* * mean Q (1/16) */
+    Value /= (uint32_t)S_xx;       /* slope * mean Q */
+    S_y -= (int32_t)Value;         /* intercept (1/16 ADC counts) */
+
+    R_s = 0;                       /* default */
+    if (S_y > 0)                   /* valid intercept */
+    {
+      Value = (uint32_t)S_y;
+      Value *= R_Total * 10UL;     /* in 0.01 Ohms */
+      S_x = (int32_t)(U_ref - Buffer[0]) * 16;
+      S_x -= S_y;                  /* voltage across charging resistance */
+      if (S_x > 0)
+      {
+        Value /= (uint32_t)S_x;
+        if (Value < UINT16_MAX) R_s = (uint16_t)Value;
+      }
+    }
+
+    /* ESR: remove RiL of probe-2 */
+    Value = NV.RiL * 10;           /* RiL in 0.01 Ohms */
+    if (R_s > Value) Cap->ESR = R_s - Value;
+
+
+    /*
+     *  capacitance
+     *  - C' = Ticks * 2^Shift / 2 * S_xx / (R_total * S_xy)
+     *  - C = C' * R_total / (R_total + R_s)
+     *    = time * S_xx / (S_xy * (R_total + R_s))
+     */
+
+    Scale = -9;                    /* nF */
+
+    /* time per unit of charge in s */
+    Value = Ticks;
+    Value <<= Shift;
+    Value *= 32;                   /* * 64 (prescaler) / 2 (trapezoid) */
+    Value /= MCU_CYCLES_PER_US;
+
+    while (Value > (UINT32_MAX / UINT16_MAX))   /* prevent overflow */
+    {
+      Value = Div10(Value);
+      Scale++;
+    }
+    Value *= (uint32_t)S_xx;
+    Value /= (uint32_t)S_xy;
+
+    while (Value > (UINT32_MAX / 10000))   /* prevent overflow */
+    {
+      Value = Div10(Value);
+      Scale++;
+    }
+    Value *= 10000;                /* s/Ohm = F, 0.1 Ohms -> nF */
+    Value /= R_Total + (R_s / 10);
+
+    while (Value > (UINT32_MAX / 1000))    /* keep some headroom */
+    {
+      Value = Div10(Value);
+      Scale++;
+    }
+
+    if (Value == 0) Flag = 0;      /* sanity check */
+
+    /* copy data */
+    Cap->A = Probes.ID_2;          /* pull-down probe pin */
+    Cap->B = Probes.ID_1;          /* pull-up probe pin */
+    Cap->Scale = Scale;
+    Cap->Raw = Value;
+    Cap->Value = Value;
+  }
+
+
+  /*
+   *  self-discharge
+   *  - least-squares fit of voltage vs. time
+   *  - time index centered and doubled: u = 2t - 31
+   *  - slope = 2 * S_uy / S_uu with S_uu = 10912 for 32 samples
+   */
+
+  if (Flag == 3)
+  {
+    /* interval at least 4ms */
+    if (Ticks < FIT_TICKS_HOLD) Ticks = FIT_TICKS_HOLD;
+    ADC_CaptureInterval(Ticks);
+
+    S_xy = 0;
+    i = 0;
+    while (i <= FIT_HOLD)          /* first sample is skipped */
+    {
+      X = ADC_CaptureSample();     /* get sample */
+
+      if (i > 0)                   /* skip settling sample */
+      {
+        if (i == 1) Buffer[0] = X; /* voltage at start */
+        Y = (2 * (i - 1)) - (FIT_HOLD - 1);
+        S_xy += (int32_t)Y * X;
+      }
+
+      i++;
+      wdt_reset();                 /* reset watchdog */
+    }
+
+    if (S_xy < 0)                  /* voltage dropped */
+    {
+      /* drop over 31 intervals in 0.01 ADC counts */
+      Value = -S_xy;
+      Value *= (FIT_HOLD - 1) * 100;
+      Value /= 5456;               /* S_uu / 2 */
+
+      /* if voltage drop is too large, consider DUT not to be a cap */
+      if (Value > 10000) Flag = 0;
+      else
+      {
+        #ifdef SW_C_VLOSS
+        /* voltage loss in 0.1% */
+        if (Buffer[0] > 0)
+        {
+          Cap->U_loss = (uint16_t)((Value * 10) / Buffer[0]);
+        }
+        #endif
+
+        /* convert drop to 0.01mV */
+        Value *= Cfg.Bandgap;
+        Value /= 1024;
+        Q = Value;                 /* save drop */
+
+
+        /*
+         *  calculate leakage current
+         *  - I = C * U_diff / t
+         *  - C * 0.01mV / s -> 10^(Scale + 1) A
+         */
+
+        Value = Cap->Value;
+        Scale = Cap->Scale;
+        while (Value > 30000)      /* rescale to prevent overflow */
+        {
+          Value = Div10(Value);
+          Scale++;
+        }
+
+        Value *= Q;                /* * U_diff (0.01mV) */
+        Scale++;                   /* 10^-5 V / 10^-6 s */
+
+        while ((Value > 0) && (Value < 100000000))    /* increase resolution */
+        {
+          Value *= 10;
+          Scale--;
+        }
+
+        /* / t (s) */
+        Q = Ticks;
+        Q *= (FIT_HOLD - 1) * 64UL;
+        Q /= MCU_CYCLES_PER_US;
+        Value /= Q;
+
+        while (Value > UINT16_MAX) /* scale to uint16_t */
+        {
+          Value = Div10(Value);
+          Scale++;
+        }
+
+        Cap->I_leak_Value = (uint16_t)Value;
+        Cap->I_leak_Scale = Scale;
+      }
+    }
+  }
+
+
+  /*
+   *  clean up
+   */
+
+  ADC_CaptureStop();               /* stop timer and restore ADC */
+
+  if (Flag != 3)                   /* failed */
+  {
+    /* reset cap data */
+    Cap->Scale = -12;
+    Cap->Raw = 0;
+    Cap->Value = 0;
+    Cap->I_leak_Value = 0;
+    Cap->ESR = 0;
+    #ifdef SW_C_VLOSS
+    Cap->U_loss = 0;
+    #endif
+  }
+
+  /* clean up local constants */
+  #undef FIT_TICKS_MIN
+  #undef FIT_TICKS_MAX
+  #undef FIT_TICKS_HOLD
+  #undef FIT_HOLD
+
+  return Flag;
+}
+
+#endif
+
+
+
 /*
  *  measure cap >4.7F between two probe pins
  *
@@ -894,6 +1388,13 @@ uint8_t LargeCap(Capacitor_Type *Cap)
   uint32_t          Raw;           /* raw capacitance value */
   uint32_t          Value;         /* corrected capacitance value */
 
+  #ifdef SW_C_FIT
+  /* try curve fitting first */
+  Flag = LargeCapFit(Cap);
+  if (Flag > 0) return Flag;       /* got result */
+  Flag = 3;                        /* fall back to pulse method */
+  #endif
+
   /* set up mode */
   Mode = PULL_10MS | PULL_UP;      /* start with large cap (>47uF) */
 
@@ -1144,7 +1645,7 @@ large_cap:
     
     while (Value > 800000)    /* rescale if necessary */
     {
-      Value /= 10;
+      Value = Div10(Value);
       Scale++;
     }
 
@@ -1159,7 +1660,7 @@ large_cap:
 
     while (Value > UINT16_MAX)     /* scale to uint16_t */
     {
-      Value /= 10;
+      Value = Div10(Value);
       Scale++;
     }
 
@@ -1592,6 +2093,9 @@ void MeasureCap(uint8_t Probe1, uint8_t Probe2, uint8_t ID)
   #ifdef SW_C_VLOSS
   Cap->U_loss = 0;
   #endif
+  #ifdef SW_C_FIT
+  Cap->ESR = 0;
+  #endif
 
   if (Check.Found == COMP_ERROR) return;    /* skip check on any error */
 
@@ -1647,8 +2151,20 @@ void MeasureCap(uint8_t Probe1, uint8_t Probe2, uint8_t ID)
 
   UpdateProbes2(Probe1, Probe2);        /* update probes */
 
-  /* first run measurement for large caps */ 
-  TempByte = LargeCap(Cap);
+  /*
+   *  first run measurement for large caps
+   *  - skip for FET/IGBT, since gate capacitances are always below
+   *    the range of this method
+   */
+
+  if ((Check.Found == COMP_FET) || (Check.Found == COMP_IGBT))
+  {
+    TempByte = 2;                       /* signal small cap */
+  }
+  else
+  {
+    TempByte = LargeCap(Cap);
+  }
 
   /* if cap is too small run measurement for small caps */
   if (TempByte == 2)
@@ -1695,6 +2211,96 @@ void MeasureCap(uint8_t Probe1, uint8_t Probe2, uint8_t ID)
 
 
 
+#ifdef SW_MONITOR_TRACK
+
+/*
+ *  track a known cap (C monitors)
+ *  - re-measures cap with the method which found it, i.e. skips the
+ *    plausibility checks of MeasureCap() and, for small caps, the
+ *    attempt with the method for large caps
+ *  - probes are taken from cap data
+ *
+ *  requires:
+ *  - Cap: pointer to cap data
+ *
+ *  returns:
+ *  - 1 if new value is within tracking window
+ *  - 0 if not or on any problem
+ */
+
+uint8_t TrackCap(Capacitor_Type *Cap)
+{
+  uint8_t           Flag = 0;      /* return value */
+  int8_t            Scale;         /* former scale */
+  uint32_t          Value;         /* former value */
+  uint32_t          Window;        /* tracking window */
+
+  /* save former value */
+  Value = Cap->Value;
+  Scale = Cap->Scale;
+  if (Value == 0) return Flag;          /* no cap */
+
+  /* reset cap data (keep probes) */
+  Cap->Raw = 0;
+  Cap->Value = 0;
+  Cap->I_leak_Value = 0;
+  #ifdef SW_C_VLOSS
+  Cap->U_loss = 0;
+  #endif
+  #ifdef SW_C_FIT
+  Cap->ESR = 0;
+  #endif
+
+  Check.Found = COMP_NONE;              /* reset component */
+  UpdateProbes2(Cap->B, Cap->A);        /* pull-up, pull-down probe */
+
+  /* run measurement based on former value */
+  if (CmpValue(Value, Scale, 4700, -9) >= 0)     /* large cap */
+  {
+    Flag = LargeCap(Cap);
+  }
+  else                                           /* small cap */
+  {
+    Flag = SmallCap(Cap);
+  }
+
+  if (Flag == 3)                        /* got value */
+  {
+    /* check tracking window */
+    Window = Value / TRACK_WINDOW;
+    Flag = 0;
+
+    if ((CmpValue(Cap->Value, Cap->Scale, Value - Window, Scale) >= 0) &&
+        (CmpValue(Cap->Value, Cap->Scale, Value + Window, Scale) <= 0))
+    {
+      Check.Found = COMP_CAPACITOR;     /* still a cap */
+      Flag = 1;
+    }
+  }
+  else                                  /* any problem */
+  {
+    Flag = 0;
+  }
+
+  /*
+   *  clean up
+   *  - no extra discharge, since LargeCap() and SmallCap() discharge the
+   *    DUT before measuring, as do MeasureCap() and MeasureESR()
+   */
+
+  /* reset all ports and pins */
+  ADC_DDR = 0;                     /* set ADC port to input */
+  ADC_PORT = 0;                    /* set ADC port low */
+  R_DDR = 0;                       /* set resistor port to input */
+  R_PORT = 0;                      /* set resistor port low */
+
+  return Flag;
+}
+
+#endif
+
+
+
 #ifdef HW_ADJUST_CAP
 
 /*
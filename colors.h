@@ -429,6 +429,12 @@
 #define COLOR_BAT_WEAK        COLOR_YELLOW
 #define COLOR_BAT_LOW         COLOR_RED
 
+/* binning */
+#define COLOR_BIN_1           COLOR_GREEN
+#define COLOR_BIN_2           COLOR_YELLOW
+#define COLOR_BIN_3           COLOR_ORANGE
+#define COLOR_BIN_FAIL        COLOR_RED
+
 
 
 /* ************************************************************************
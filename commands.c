@@ -1447,6 +1447,56 @@ uint8_t Cmd_V_GT(void)
 
 
 
+#ifdef SW_SCR_CURRENTS
+
+/*
+ *  command: I_GT / I_LATCH / I_HOLD
+ *  - return currents of thyristor/TRIAC
+ *    I_GT value (gate trigger current)
+ *    I_L value (latching current)
+ *    I_H value (holding current)
+ *
+ *  requires:
+ *  - Cmd: command ID
+ *
+ *  returns:
+ *  - SIGNAL_ERR on error
+ *  - SIGNAL_NA on n/a
+ *  - SIGNAL_OK on success
+ */
+
+uint8_t Cmd_I_GT(uint8_t Cmd)
+{
+  uint8_t           Flag = SIGNAL_NA;   /* return value */
+  uint32_t          Value;              /* current */
+
+  /* SCR or TRIAC */
+  if ((Check.Found == COMP_THYRISTOR) || (Check.Found == COMP_TRIAC))
+  {
+    if (Cmd == CMD_I_GT) Value = SCR.I_GT;          /* I_GT */
+    else if (Cmd == CMD_I_LATCH) Value = SCR.I_L;   /* I_L */
+    else Value = SCR.I_H;                           /* I_H */
+
+    if (Value > 0)                      /* if not zero */
+    {
+      /* send value */
+      Display_Value(Value, -9, 'A');         /* in nA */
+
+      Flag = SIGNAL_OK;                 /* signal ok */
+    }
+  }
+  else                                  /* other component */
+  {
+    Flag = SIGNAL_ERR;                  /* signal error */
+  }
+
+  return Flag;
+}
+
+#endif
+
+
+
 /*
  *  command: V_T
  *  - return V_T value
@@ -1614,6 +1664,133 @@ uint8_t Cmd_V_F_clamp(void)
 
 
 
+#ifdef SW_HFE_SWEEP
+
+/*
+ *  command: HFE_SWEEP
+ *  - run hFE sweep and return table
+ *  - one line per operating point: I_b I_c V_BE hFE
+ *
+ *  returns:
+ *  - SIGNAL_ERR on error
+ *  - SIGNAL_NA on n/a
+ *  - SIGNAL_OK on success
+ */
+
+uint8_t Cmd_HFE_SWEEP(void)
+{
+  uint8_t           Flag = SIGNAL_OK;   /* return value */
+  uint8_t           n = 0;              /* counter */
+  Sweep_Type        *Point;             /* pointer to operating point */
+
+  if (Check.Found == COMP_BJT)          /* BJT */
+  {
+    if (Info.Flags & INFO_BJT_R_BE)     /* R_BE detected */
+    {
+      /* B-E resistor renders values useless */
+      Flag = SIGNAL_NA;                 /* signal n/a */
+    }
+    else if (BJT_Sweep() == 0)          /* sweep failed */
+    {
+      Flag = SIGNAL_NA;                 /* signal n/a */
+    }
+    else                                /* got table */
+    {
+      /* send table */
+      while (n < HFE_Points)
+      {
+        if (n > 0) Serial_NewLine();    /* new line for next point */
+
+        Point = &HFE_Sweep[n];
+        Display_Value(Point->I_b, -9, 'A');       /* I_b in nA */
+        Display_Space();
+        Display_Value(Point->I_c, -9, 'A');       /* I_c in nA */
+        Display_Space();
+        Display_Value(Point->U_be, -3, 'V');      /* V_BE in mV */
+        Display_Space();
+        Display_Value2(Point->hFE);               /* hFE */
+
+        n++;                            /* next point */
+      }
+    }
+  }
+  else                                  /* other component */
+  {
+    Flag = SIGNAL_ERR;                  /* signal error */
+  }
+
+  return Flag;
+}
+
+#endif
+
+
+
+#ifdef SW_DIODE_CURVE
+
+/*
+ *  command: D_CURVE
+ *  - run I/V curve of diode and return table and Shockley fit
+ *  - one line per curve point: I_f V_f
+ *  - last line: n Is Rs class
+ *
+ *  returns:
+ *  - SIGNAL_ERR on error
+ *  - SIGNAL_NA on n/a
+ *  - SIGNAL_OK on success
+ */
+
+uint8_t Cmd_D_CURVE(void)
+{
+  uint8_t           Flag = SIGNAL_OK;   /* return value */
+  uint8_t           n = 0;              /* counter */
+  Diode_Type        *D;                 /* pointer to diode */
+
+  if (Check.Found == COMP_DIODE)        /* diode(s) */
+  {
+    D = (Diode_Type *)SelectedComp();   /* get pointer */
+
+    if ((D == NULL) || (Diode_Curve(D) == 0))     /* no curve */
+    {
+      Flag = SIGNAL_NA;                 /* signal n/a */
+    }
+    else                                /* got curve */
+    {
+      /* send table */
+      while (n < CurvePoints)
+      {
+        Display_Value(DiodeCurve[n].I_f, -9, 'A');     /* I_f in nA */
+        Display_Space();
+        Display_Value(DiodeCurve[n].V_f, -3, 'V');     /* V_f in mV */
+        Serial_NewLine();               /* new line for next point */
+
+        n++;                            /* next point */
+      }
+
+      /* send Shockley parameters */
+      Display_FullValue(DiodeFit.n, 2, 0);             /* n */
+      Display_Space();
+      Display_FullValue(DiodeFit.I_s, 1, 0);           /* Is mantissa */
+      Display_Char('e');
+      Display_SignedValue(DiodeFit.I_s_Exp, 0, 'A');   /* Is exponent */
+      Display_Space();
+      Display_Value(DiodeFit.R_s, -2, LCD_CHAR_OMEGA); /* Rs */
+      Display_Space();
+      Show_DiodeClass(DiodeFit.Class);                 /* class */
+    }
+  }
+  else                                  /* other component */
+  {
+    Flag = SIGNAL_ERR;                  /* signal error */
+  }
+
+  return Flag;
+}
+
+#endif
+
+
+
 /* ************************************************************************
  *   command parsing and processing
  * ************************************************************************ */
@@ -1891,6 +2068,14 @@ uint8_t RunCommand(uint8_t ID)
       Flag = Cmd_V_GT();                     /* run command */
       break;
 
+    #ifdef SW_SCR_CURRENTS
+    case CMD_I_GT:            /* return I_GT */
+    case CMD_I_LATCH:         /* return latching current */
+    case CMD_I_HOLD:          /* return holding current */
+      Flag = Cmd_I_GT(ID);                   /* run command */
+      break;
+    #endif
+
     case CMD_V_T:             /* return V_T */
       Flag = Cmd_V_T();                      /* run command */
       break;
@@ -1920,6 +2105,18 @@ uint8_t RunCommand(uint8_t ID)
       break;
     #endif    
 
+    #ifdef SW_HFE_SWEEP
+    case CMD_HFE_SWEEP:       /* return hFE sweep table */
+      Flag = Cmd_HFE_SWEEP();                /* run command */
+      break;
+    #endif
+
+    #ifdef SW_DIODE_CURVE
+    case CMD_D_CURVE:         /* return diode I/V curve and fit */
+      Flag = Cmd_D_CURVE();                  /* run command */
+      break;
+    #endif
+
     default:                  /* unknown/unsupported */
       Flag = SIGNAL_ERR;                     /* signal error */
       break;
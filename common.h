@@ -175,6 +175,7 @@
 #define NUM_E12              12         /* E12 norm values */
 #define NUM_E24              24         /* E24 norm values */
 #define NUM_E96              96         /* E24 norm values */
+#define NUM_E_CACHE           4         /* E series lookup cache (E6-E96) */
 #define NUM_COLOR_CODES      10         /* color codes */
 #define NUM_EIA96_MULT        9         /* EIA-96 multiplier codes */
 #define NUM_LOGIC_TYPES       6         /* logic families and voltages */
@@ -182,6 +183,12 @@
 /* IR code buffer size */
 #define IR_CODE_BYTES         6         /* 6 bytes = 48 bit */
 
+/* learned IR codes */
+#define IR_SLOTS              4         /* number of slots */
+#define IR_SLOT_BITS          2         /* bits for slot number */
+#define IR_SLOT_PULSES      100         /* max. number of pauses/pulses */
+#define IR_SLOT_SYMBOLS       8         /* max. number of durations */
+
 
 
 /* ************************************************************************
@@ -237,6 +244,11 @@
 #define CMD_V_L               46   /* return V_loss */
 #define CMD_V_F_CLAMP         47   /* return V_f of clamping diode */
 #define CMD_C_BE              48   /* return C_BE */
+#define CMD_HFE_SWEEP         49   /* return hFE sweep table */
+#define CMD_D_CURVE           50   /* return diode I/V curve and fit */
+#define CMD_I_GT              51   /* return I_GT */
+#define CMD_I_LATCH           52   /* return latching current */
+#define CMD_I_HOLD            53   /* return holding current */
 
 
 
@@ -353,6 +365,38 @@
 #define PULL_10MS             0b00010000     /* pull for 10ms */
 
 
+/* curve fitting for large caps */
+#define FIT_SAMPLES           64             /* sample buffer size */
+
+/* waveform view */
+#define WAVE_SAMPLES          64             /* sample buffer size */
+
+/* hFE sweep of BJTs */
+#define HFE_POINTS            4              /* number of operating points */
+
+/* trend of cap leakage */
+#define LEAK_POINTS           8              /* size of log (2^n) */
+
+/* I/V curve of diodes */
+#define CURVE_POINTS          4              /* number of curve points */
+
+/* diode class (based on I/V curve) */
+#define DIODE_SCHOTTKY        1              /* Schottky or Ge */
+#define DIODE_SILICON         2              /* Si */
+#define DIODE_LED_IR          3              /* IR LED */
+#define DIODE_LED_RED         4              /* red LED */
+#define DIODE_LED_YG          5              /* yellow/green LED */
+#define DIODE_LED_BW          6              /* blue/white LED */
+
+/* tracking mode of R/C/L monitors */
+#define TRACK_WINDOW          8              /* window: +/- 1/8 of value */
+#ifdef SW_MONITOR_TRACK
+  #define MONITOR_WAIT        250            /* update interval (ms) */
+#else
+  #define MONITOR_WAIT        1000           /* update interval (ms) */
+#endif
+
+
 
 /* ************************************************************************
  *   constants for display output
@@ -431,6 +475,18 @@
 #define BUZZER_FREQ_HIGH      1              /* 5 kHz */
 
 
+/* IR decoder: timing control flags (bitfield) */
+#define IR_STD_TOLER          0b00000000     /* use default tolerance */
+#define IR_RELAX_SHORT        0b00000001     /* relax short pulses */
+#define IR_RELAX_LONG         0b00000010     /* relax long pulses */
+
+/* IR decoder: flags for PDM protocol table (bitfield) */
+#define IR_TAB_MSB            0b00000001     /* MSB bit mode (default: LSB) */
+#define IR_TAB_EXT_INV        0b00000010     /* show extra field only if it's not the inverted address */
+#define IR_TAB_TRAILING       0b00000100     /* partial second packet may follow */
+#define IR_TAB_BAD            0b00001000     /* report bad packet for matching start */
+
+
 /* port pins of PCF8574 I2C IO chip */
 #define PCF8574_P0            0b00000000     /* pin #0 */
 #define PCF8574_P1            0b00000001     /* pin #1 */
@@ -483,6 +539,9 @@ typedef struct
   uint8_t           Ref;           /* track reference source used lastly */
   uint16_t          Bandgap;       /* voltage of internal bandgap reference (mV) */
   uint16_t          Vcc;           /* voltage of Vcc (mV) */
+  #ifdef SW_ESR_GATETIME
+  uint8_t           ESR_Gate;      /* gate time for ESR measurement (100ms) */
+  #endif
   #ifndef BAT_NONE
   uint16_t          Vbat;          /* battery voltage (mV) */
   uint8_t           BatTimer;      /* timer for battery check (100ms) */
@@ -665,6 +724,9 @@ typedef struct
   #ifdef SW_C_VLOSS
   uint16_t          U_loss;        /* voltage loss (in 0.1%) */
   #endif
+  #ifdef SW_C_FIT
+  uint16_t          ESR;           /* ESR by curve fitting (in 0.01 Ohms) */
+  #endif
 } Capacitor_Type;
 
 
@@ -733,6 +795,82 @@ typedef struct
 */
 
 
+/* learned component (fast re-test) */
+typedef struct
+{
+  uint8_t           Found;         /* component type */
+  uint8_t           Type;          /* component sub-type */
+  uint8_t           A;             /* probe ID of pin A (B/G or anode) */
+  uint8_t           B;             /* probe ID of pin B (C/D or cathode) */
+  uint8_t           C;             /* probe ID of pin C (E/S or unused) */
+} Learn_Type;
+
+
+/* binning reference */
+typedef struct
+{
+  Learn_Type        Comp;          /* learned component */
+  uint16_t          Value_1;       /* hFE, V_th (mV) or V_f (mV) */
+  uint16_t          Value_2;       /* V_BE (mV) */
+} Bin_Type;
+
+
+/* operating point of hFE sweep */
+typedef struct
+{
+  uint32_t          I_b;           /* base current (nA) */
+  uint32_t          I_c;           /* collector current (nA) */
+  uint16_t          U_be;          /* V_BE (mV) */
+  uint16_t          hFE;           /* hFE */
+} Sweep_Type;
+
+
+/* sampled voltage of Zener check */
+typedef struct
+{
+  uint16_t          Mean;          /* mean voltage */
+  uint16_t          Min;           /* min. voltage */
+  uint16_t          Max;           /* max. voltage */
+} Zener_Type;
+
+
+/* log entry of cap leakage */
+typedef struct
+{
+  uint16_t          Time;          /* time since start (s) */
+  uint16_t          U;             /* voltage at cap (mV) */
+  uint32_t          I;             /* leakage current (0.1nA) */
+} Leak_Type;
+
+
+/* point of diode I/V curve */
+typedef struct
+{
+  uint32_t          I_f;           /* forward current (nA) */
+  uint16_t          V_f;           /* forward voltage (mV) */
+} Curve_Type;
+
+
+/* Shockley diode model */
+typedef struct
+{
+  uint16_t          n;             /* emission coefficient (0.01) */
+  uint16_t          R_s;           /* series resistance (0.01 Ohms) */
+  uint8_t           I_s;           /* saturation current: mantissa (0.1) */
+  int8_t            I_s_Exp;       /* saturation current: exponent (10^x A) */
+  uint8_t           Class;         /* diode class */
+} Shockley_Type;
+
+
+/* currents of thyristor/TRIAC */
+typedef struct
+{
+  uint32_t          I_GT;          /* gate trigger current (nA) */
+  uint32_t          I_L;           /* latching current (nA) */
+  uint32_t          I_H;           /* holding current (nA) */
+} SCR_Type;
+
+
 /* special semiconductors */
 typedef struct
 {
@@ -802,6 +940,40 @@ typedef struct
 } Cmd_Type;
 
 
+/* IR protocol with start sequence and PDM (decoder table) */
+typedef struct
+{
+  uint8_t           Pulse;         /* start pulse (in 50s), 0 for end of table */
+  uint8_t           Pause;         /* start pause (in 50s) */
+  uint8_t           PulseCtrl;     /* timing control for start pulse */
+  uint8_t           PauseCtrl;     /* timing control for start pause */
+  uint8_t           tS;            /* spacer pulse (in 50s) */
+  uint8_t           t0;            /* pause for 0 (in 50s) */
+  uint8_t           t1;            /* pause for 1 (in 50s) */
+  uint8_t           DataCtrl;      /* timing control for data */
+  uint8_t           Bits;          /* number of bits */
+  uint8_t           Flags;         /* decoder/output flags */
+  uint8_t           Addr_Pos;      /* address: start bit (1-) */
+  uint8_t           Addr_Len;      /* address: number of bits */
+  uint8_t           Cmd_Pos;       /* command: start bit (1-) */
+  uint8_t           Cmd_Len;       /* command: number of bits */
+  uint8_t           Ext_Pos;       /* extra field: start bit (1-), 0 for none */
+  uint8_t           Ext_Len;       /* extra field: number of bits */
+  const unsigned char    *Name;    /* storage address of protocol name */
+} IR_PDM_Type;
+
+
+/* learned IR code (raw) */
+typedef struct
+{
+  uint8_t           Pulses;        /* number of pauses/pulses, 0 for empty */
+  uint8_t           Symbol[IR_SLOT_SYMBOLS];    /* durations (in 50s) */
+  /* symbol index for each pause/pulse (4 bits, first one in high nibble) */
+  /* starts with pulse and alternates between pulse and pause */
+  uint8_t           Data[IR_SLOT_PULSES / 2];
+} IR_Slot_Type;
+
+
 
 /* ************************************************************************
  *   EOF
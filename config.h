@@ -169,6 +169,18 @@
 #define ZENER_VOLTAGE_MAX     30000     /* max. voltage in mV */
 
 
+/*
+ *  Zener check: timer gated sampling
+ *  - bursts of 32 samples spread over 20ms instead of single readings
+ *  - Zener tool shows mean voltage and ripple (peak-to-peak), hold value
+ *    is the moving average instead of the minimum
+ *  - uses Timer1
+ *  - uncomment to enable
+ */
+
+//#define ZENER_SYNC
+
+
 /*
  *  fixed signal output
  *  - in case the MCU's OC1B pin is wired as dedicated signal output
@@ -319,6 +331,18 @@
 #define LOGIC_PROBE_R2        3300
 
 
+/*
+ *  Logic Probe: detect pulses
+ *  - fast sampling with ADC in free running mode
+ *  - shows 'P' for pulsing signals, plus frequency and duty cycle
+ *    for periodic signals (up to about 15kHz)
+ *  - requires HW_LOGIC_PROBE
+ *  - uncomment to enable
+ */
+
+//#define LOGIC_PROBE_PULSE
+
+
 /*
  *  Buzzer
  *  - see BUZZER_CTRL in config_<MCU>.h for port pin
@@ -444,6 +468,20 @@
 #define SW_INDUCTOR
 
 
+/*
+ *  inductance measurement: skip capacitive spikes
+ *  - low test current run skips capacitive spikes of large inductors
+ *    (crossings within the first 5s followed by a drop below the
+ *    threshold) and waits for the next crossing
+ *  - replaces the extra run with delayed start, i.e. one run less
+ *  - doesn't change the measurement range
+ *  - requires SW_INDUCTOR
+ *  - uncomment to enable
+ */
+
+//#define SW_L_SKIP_SPIKE
+
+
 /*
  *  ESR measurement
  *  - requires MCU clock >= 8 MHz
@@ -464,6 +502,31 @@
 //#define SW_ESR_TOOL
 
 
+/*
+ *  ESR measurement: fixed gate-time averaging
+ *  - averages the pulse measurements over a fixed gate time instead
+ *    of a fixed number of pulses
+ *  - gate time is a multiple of 100ms, i.e. whole periods of mains hum
+ *    (50/60Hz), which reduces its influence
+ *  - that's the only gain, the pulses and their sampling are the same
+ *    as for the standard measurement (timed by software relative to
+ *    the ADC's S&H)
+ *  - no timer-driven pulses: Timer1's outputs (OC1A/OC1B) can't drive
+ *    Rl of any probe pair (ATmega328: just Rh of probe #1 and Rl of
+ *    probe #2, other MCUs: none), and toggling Rl in an ISR would add
+ *    interrupt latency jitter to the pulse of just a few s
+ *  - ESR_GATE: gate time in 100ms (1-6), 2 is about the speed of the
+ *    standard measurement
+ *  - ESR tool: long key press measures with 5 times the gate time
+ *  - uses Timer1
+ *  - requires SW_ESR or SW_OLD_ESR to be enabled
+ *  - uncomment to enable
+ */
+
+//#define SW_ESR_GATETIME
+#define ESR_GATE              2
+
+
 /*
  *  check for rotary encoders
  *  - uncomment to enable
@@ -532,6 +595,17 @@
 //#define SW_IR_RX_EXTRA
 
 
+/*
+ *  sample IR signal via Timer1 input capture
+ *  - analog comparator detects edges of the data signal
+ *  - precise timing and supports back-to-back packets
+ *  - only for IR receiver module connected to probes (SW_IR_RECEIVER)
+ *  - uncomment to enable
+ */
+
+//#define SW_IR_RX_CAPTURE
+
+
 /*
  *  IR remote control sender
  *  - signal output via OC1B
@@ -553,6 +627,34 @@
 //#define SW_IR_TX_ALTDELAY
 
 
+/*
+ *  timer-driven IR remote control sender
+ *  - precomputes a pulse schedule and gates the carrier by Timer1's
+ *    overflow interrupt, i.e. timing is exact to the carrier period
+ *  - repeats code as long as the test key is pressed
+ *  - makes delay loop (and SW_IR_TX_ALTDELAY) obsolete
+ *  - requires about 180 bytes RAM
+ *  - uncomment to enable
+ */
+
+//#define SW_IR_TX_TIMER
+
+
+/*
+ *  learn and replay IR codes
+ *  - long key press in IR detector stores last packet (raw) in EEPROM
+ *  - IR sender replays stored packets ("Raw" protocol)
+ *  - 4 slots, requires 236 bytes of EEPROM
+ *  - durations are clustered into up to 8 symbols
+ *  - carrier frequency isn't captured, default is 38kHz
+ *  - requires IR detector (SW_IR_RECEIVER or HW_IR_RECEIVER)
+ *    and IR sender (SW_IR_TRANSMITTER)
+ *  - uncomment to enable
+ */
+
+//#define SW_IR_LEARN
+
+
 /*
  *  additional protocols for IR remote control sender
  *  - uncommon protocols which will increase flash memory usage ;)
@@ -647,6 +749,52 @@
 //#define SW_CAP_LEAKAGE
 
 
+/*
+ *  trend of capacitor leakage check
+ *  - logs current in low current mode (Rh) and predicts the final leakage
+ *    current and the time to reach it (display line #4)
+ *  - serial copy (UI_SERIAL_COPY) sends each log point and the prediction
+ *  - requires SW_CAP_LEAKAGE
+ *  - uncomment to enable
+ */
+
+//#define SW_CAP_LEAK_TREND
+
+
+/*
+ *  waveform view: step response of DUT
+ *  - applies a voltage step via Rl and captures the voltage at a fixed
+ *    sampling interval (200s - 50ms)
+ *  - shows final voltage and time constant, samples can be scrolled
+ *    with right/left keys
+ *  - uses probe #1 (pos) and probe #3 (neg)
+ *  - requires additional 130 bytes of RAM (stack)
+ *  - uncomment to enable
+ */
+
+//#define SW_WAVEFORM
+
+
+/*
+ *  binning: sort BJTs, enhancement-mode MOSFETs, IGBTs and diodes
+ *  - long key press learns reference part (type, pinout and values)
+ *    and stores it in the EEPROM
+ *  - following parts are checked for the learned type and pinout only
+ *    (BJT: C-E in both directions and B-E junction, FET/IGBT: both
+ *    D-S directions, diode: both directions and third probe isolated)
+ *  - a diode reference rejects parts with further junctions, e.g.
+ *    BJTs, dual and anti-parallel diodes
+ *  - compares hFE and V_BE (BJT), V_th (FET/IGBT) or V_f (diode)
+ *  - BIN_TOLERANCE: tolerance of bin #1 in %, bin #2 and #3 have
+ *    2 and 4 times the tolerance
+ *  - result is signaled by color (color display) and buzzer
+ *  - uncomment to enable
+ */
+
+//#define SW_BINNING
+#define BIN_TOLERANCE         2
+
+
 /*
  *  display reverse hFE for BJTs
  *  - hFE for collector and emitter reversed
@@ -666,6 +814,58 @@
 //#define SW_HFE_CURRENT
 
 
+/*
+ *  hFE sweep for BJTs (hFE vs. I_c)
+ *  - measures I_b, I_c, V_BE and hFE for 4 operating points
+ *    (about 10A to 6mA)
+ *  - graphic displays show a mini curve
+ *  - remote command HFE_SWEEP returns the table
+ *  - uncomment to enable
+ */
+
+//#define SW_HFE_SWEEP
+
+
+/*
+ *  I/V curve of diodes with Shockley fit
+ *  - measures V_f for 4 test currents (about 5A to 6mA)
+ *  - fits emission coefficient n, saturation current Is and
+ *    series resistance Rs
+ *  - classifies diode as Schottky, Si or LED (color by V_f)
+ *  - single diodes only
+ *  - remote command D_CURVE returns the table and the fit
+ *  - uncomment to enable
+ */
+
+//#define SW_DIODE_CURVE
+
+
+/*
+ *  gate trigger, latching and holding current of thyristors and TRIACs
+ *  - steps gate drive (about 10A and 6mA) and anode load (about
+ *    6mA, 3mA and 10A) through the probe resistors
+ *  - values are the lowest test currents which still trigger, latch
+ *    or hold the DUT, i.e. upper limits
+ *  - TRIACs are checked in Q1
+ *  - remote commands I_GT, I_LATCH and I_HOLD return the values
+ *  - uncomment to enable
+ */
+
+//#define SW_SCR_CURRENTS
+
+
+/*
+ *  leakage current measurement with adaptive integration time
+ *  - low current range (Rh) of semiconductor leakage and cap leakage tool
+ *  - timer gated ADC bursts until reading is stable (max. about 320ms)
+ *  - resolution down to about 0.1nA
+ *  - uses Timer1
+ *  - uncomment to enable
+ */
+
+//#define SW_LEAKAGE_AUTO
+
+
 /*
  *  display C_be (base-emitter capacitance) for BJTs
  *  - uncomment to enable
@@ -699,6 +899,19 @@
 //#define SW_MONITOR_HOLD_L     /* auto-hold L (L monitor) */
 
 
+/*
+ *  R/C/L monitors: tracking mode
+ *  - once a component is found, just the value is re-measured with the
+ *    same probe setup (no full detection), and the update interval is
+ *    shortened
+ *  - full detection is run again when the value leaves the tracking
+ *    window (+/- 12.5%)
+ *  - uncomment to enable
+ */
+
+//#define SW_MONITOR_TRACK
+
+
 /*
  *  DHT11, DHT22 and compatible humidity & temperature sensors
  *  - uncomment to enable
@@ -761,6 +974,49 @@
 //#define SW_R_TRIMMER
 
 
+/*
+ *  fast resistor measurement
+ *  - skips settling delays and uses fewer ADC samples for readings
+ *    which are just needed for plausibility checks of resistors
+ *    < 19.5k
+ *  - checks a known resistor in reverse direction with a single
+ *    voltage divider instead of the full measurement
+ *  - the quick reverse check skips the plausibility checks of the
+ *    full measurement (Rl/Rh pull-up vs. pull-down), so it relies on
+ *    the first direction having been checked completely
+ *  - resistors < 10 Ohms are always measured fully
+ *  - uncomment to enable
+ */
+
+//#define SW_R_FAST
+
+
+/*
+ *  repeat last type: fast re-test of identical components
+ *  - remembers type and pinout of the last BJT, FET, IGBT or single
+ *    diode and checks for it first in the next probing cycle
+ *  - runs the full search only on a mismatch
+ *  - checks the same probe combinations as the binning tool (see
+ *    SW_BINNING), so reverse hFE and a freewheeling diode of a BJT
+ *    are still found, and a diode doesn't match a BJT
+ *  - uncomment to enable
+ */
+
+//#define SW_REPEAT_TYPE
+
+
+/*
+ *  gate threshold voltage of enhancement-mode MOSFETs: comparator mode
+ *  - analog comparator watches the drain and Timer1's input capture
+ *    catches the switching point, gate voltage is read with auto-scaling
+ *  - 3 runs instead of 10, timeout instead of watchdog reset
+ *  - uses Timer1
+ *  - uncomment to enable
+ */
+
+//#define SW_FET_VTH_CMP
+
+
 /*
  *  show self-discharge voltage loss (in %) of a capacitor > 50nF
  *  - uncomment to enable
@@ -769,6 +1025,21 @@
 //#define SW_C_VLOSS
 
 
+/*
+ *  measure capacitors > 4.7F by curve fitting
+ *  - charges the DUT via Rl and samples the voltage at fixed intervals
+ *    (ADC triggered by Timer1)
+ *  - least-squares fit of the RC curve provides capacitance, ESR and
+ *    self-discharge leakage
+ *  - faster for large caps and without the bias of the pulse method
+ *  - falls back to the pulse method for caps too small for the fit
+ *  - requires additional 130 bytes of RAM (stack)
+ *  - uncomment to enable
+ */
+
+//#define SW_C_FIT
+
+
 /*
  *  photodiode check
  *  - uncomment to enable
@@ -412,6 +412,11 @@
 /* options which require inductance measurement */
 #ifndef SW_INDUCTOR
 
+  /* skip capacitive spikes */
+  #ifdef SW_L_SKIP_SPIKE
+    #undef SW_L_SKIP_SPIKE
+  #endif
+
   /* L monitor */
   #ifdef SW_MONITOR_L
     #undef SW_MONITOR_L
@@ -442,12 +447,40 @@
 #endif
 
 
+/*
+ *  cap leakage trend requires SW_CAP_LEAKAGE
+ */
+
+#ifdef SW_CAP_LEAK_TREND
+  #ifndef SW_CAP_LEAKAGE
+    #undef SW_CAP_LEAK_TREND
+  #endif
+#endif
+
+
+/*
+ *  tracking mode of R/C/L monitors
+ */
+
+#ifdef SW_MONITOR_TRACK
+  #if ! defined (SW_MONITOR_R) && ! defined (SW_MONITOR_C) && ! defined (SW_MONITOR_L) && ! defined (SW_MONITOR_RCL) && ! defined (SW_MONITOR_RL)
+    #undef SW_MONITOR_TRACK
+  #endif
+#endif
+
+
 /*
  *  ESR measurement
  */
 
 /* options which require ESR measurement */
 #if ! defined (SW_ESR) && ! defined (SW_OLD_ESR)
+
+  /* fixed gate-time averaging */
+  #ifdef SW_ESR_GATETIME
+    #undef SW_ESR_GATETIME
+  #endif
+
   /* ESR tool */
   #ifdef SW_ESR_TOOL
     #undef SW_ESR_TOOL
@@ -935,6 +968,32 @@
 #endif
 
 
+/* input capture sampling requires IR receiver connected to probes */
+#ifdef SW_IR_RX_CAPTURE
+  #ifndef SW_IR_RECEIVER
+    #undef SW_IR_RX_CAPTURE
+  #endif
+#endif
+
+
+/* timer-driven IR sender requires IR sender */
+#ifdef SW_IR_TX_TIMER
+  #ifndef SW_IR_TRANSMITTER
+    #undef SW_IR_TX_TIMER
+  #endif
+#endif
+
+
+/* learning IR codes requires IR detector and IR sender */
+#ifdef SW_IR_LEARN
+  #if ! defined (SW_IR_RECEIVER) && ! defined (HW_IR_RECEIVER)
+    #undef SW_IR_LEARN
+  #elif ! defined (SW_IR_TRANSMITTER)
+    #undef SW_IR_LEARN
+  #endif
+#endif
+
+
 /*
  *  DS18B20
  */
@@ -973,6 +1032,13 @@
 #endif
 
 
+/* Zener check: timer gated sampling requires Zener check */
+#ifdef ZENER_SYNC
+  #ifndef HW_ZENER
+    #undef ZENER_SYNC
+  #endif
+#endif
+
 /* Zener check during normal probing requires unswitched or switched mode */
 #ifdef HW_PROBE_ZENER
   #if ! defined (ZENER_UNSWITCHED) && ! defined (ZENER_SWITCHED)
@@ -1040,6 +1106,12 @@
   #endif
 #endif
 
+#if defined (SW_WAVEFORM)
+  #ifndef FUNC_PROBE_PINOUT
+    #define FUNC_PROBE_PINOUT
+  #endif
+#endif
+
 #if defined (SW_MONITOR_R) || defined (SW_MONITOR_C) || defined (SW_MONITOR_L) || defined(SW_MONITOR_RCL) || defined(SW_MONITOR_RL)
   #ifndef FUNC_PROBE_PINOUT
     #define FUNC_PROBE_PINOUT
@@ -1070,6 +1142,12 @@
   #define SW_PROBEPINOUT_ESR
 #endif
 
+#if defined (SW_WAVEFORM)
+  #ifndef SW_PROBEPINOUT_ESR
+    #define SW_PROBEPINOUT_ESR
+  #endif
+#endif
+
 
 /* option: pinout for RCL monitor */
 #if defined (SW_MONITOR_R) || defined (SW_MONITOR_C) || defined (SW_MONITOR_L) || defined(SW_MONITOR_RCL)
@@ -1150,6 +1228,50 @@
 #endif
 
 
+/*
+ *  resistor measurement
+ */
+
+/* function: ReadResistor() */
+#if defined (SW_R_FAST) || defined (SW_MONITOR_TRACK)
+  #ifndef FUNC_R_QUICK
+    #define FUNC_R_QUICK
+  #endif
+#endif
+
+
+/*
+ *  component detection
+ */
+
+/* functions: LearnComponent() and friends */
+#if defined (SW_BINNING) || defined (SW_REPEAT_TYPE)
+  #ifndef FUNC_COMP_LEARN
+    #define FUNC_COMP_LEARN
+  #endif
+#endif
+
+
+/*
+ *  ADC
+ */
+
+/* functions: ProbeCurrent() */
+#if defined (SW_HFE_SWEEP) || defined (SW_DIODE_CURVE) || defined (SW_SCR_CURRENTS)
+  #ifndef FUNC_PROBE_CURRENT
+    #define FUNC_PROBE_CURRENT
+  #endif
+#endif
+
+
+/* functions: ADC_CaptureStart() and friends */
+#if defined (SW_C_FIT) || defined (SW_WAVEFORM) || defined (SW_LEAKAGE_AUTO) || defined (ZENER_SYNC)
+  #ifndef FUNC_ADC_CAPTURE
+    #define FUNC_ADC_CAPTURE
+  #endif
+#endif
+
+
 /*
  *  UI / user feedback functions
  */
@@ -480,7 +480,7 @@ void Display_Serial_Off(void)
 
 
 
-#if defined (UI_SERIAL_COMMANDS) || defined (SW_DISPLAY_REG)
+#if defined (UI_SERIAL_COMMANDS) || defined (SW_DISPLAY_REG) || (defined (SW_CAP_LEAK_TREND) && defined (UI_SERIAL_COPY))
 
 /*
  *  set output to TTL serial
@@ -817,9 +817,8 @@ void Display_FullValue(uint32_t Value, uint8_t DecPlaces, unsigned char Unit)
   Display_UseValueColor();              /* set value color */
   #endif
 
-  /* convert value into string */
-  ultoa(Value, OutBuffer, 10);          /* radix 10: max. 10 chars + /0 */
-  Length = strlen(OutBuffer);           /* get string length */
+  /* convert value into string: max. 10 chars + /0 */
+  Length = ValueToString(Value, OutBuffer);
 
   /* determine position of dot */
   if (DecPlaces == 0)                   /* no dot requested */
@@ -934,7 +933,7 @@ void Display_Value(uint32_t Value, int8_t Exponent, unsigned char Unit)
   while (Value >= 10000)
   {
     Value += 5;                       /* for automagic rounding */
-    Value = Value / 10;               /* scale down by 10^1 */
+    Value = Div10(Value);             /* scale down by 10^1 */
     Exponent++;                       /* increase exponent by 1 */
   } 
 
@@ -976,9 +975,8 @@ void Display_Value(uint32_t Value, int8_t Exponent, unsigned char Unit)
   Display_UseValueColor();              /* set value color */
   #endif
 
-  /* convert value into string */
-  utoa((uint16_t)Value, OutBuffer, 10);   /* radix 10: max. 5 chars + /0 */
-  Length = strlen(OutBuffer);             /* get string length */
+  /* convert value into string: max. 5 chars + /0 */
+  Length = ValueToString(Value, OutBuffer);
 
   /* we misuse Exponent for the dot position */
   Exponent = Length - Offset;           /* calculate position */
@@ -1912,9 +1910,8 @@ void Display_ColorCode(uint16_t Value, int8_t Scale, uint16_t TolBand)
   uint16_t          *Table;             /* pointer to table */
   uint16_t          Color = 0;          /* display color */
 
-  /* convert value into string */
-  utoa(Value, OutBuffer, 10);           /* radix 10: max. 3 chars + /0 */
-  Length = strlen(OutBuffer);           /* get string length */
+  /* convert value into string: max. 3 chars + /0 */
+  Length = ValueToString(Value, OutBuffer);
 
 
   /*
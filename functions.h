@@ -24,6 +24,9 @@
   extern void Show_SemiPinout(void);
   #endif
   extern void Show_SimplePinout(uint8_t Des1, uint8_t Des2, uint8_t Des3);
+  #ifdef SW_DIODE_CURVE
+  extern void Show_DiodeClass(uint8_t Class);
+  #endif
 
   extern void CheckVoltageRefs(void);
 
@@ -291,7 +294,7 @@
   extern void Display_Serial_Off(void);
   #endif
 
-  #if defined (UI_SERIAL_COMMANDS) || defined (SW_DISPLAY_REG)
+  #if defined (UI_SERIAL_COMMANDS) || defined (SW_DISPLAY_REG) || (defined (SW_CAP_LEAK_TREND) && defined (UI_SERIAL_COPY))
   extern void Display_Serial_Only(void);
   extern void Display_LCD_Only(void);
   #endif
@@ -435,6 +438,10 @@
 
 #ifndef USER_C
 
+  extern uint32_t Div10(uint32_t Value);
+  extern uint32_t Power10(uint8_t Exp);
+  extern uint8_t NumberOfDigits(uint32_t Value);
+  extern uint8_t ValueToString(uint32_t Value, char *Buffer);
   extern int8_t CmpValue(uint32_t Value1, int8_t Scale1,
     uint32_t Value2, int8_t Scale2);
   extern uint32_t RescaleValue(uint32_t Value, int8_t Scale, int8_t NewScale);
@@ -535,6 +542,14 @@
   extern void Cap_Leakage(void);
   #endif
 
+  #ifdef SW_WAVEFORM
+  extern void Waveform_Tool(void);
+  #endif
+
+  #ifdef SW_BINNING
+  extern void Binning_Tool(void);
+  #endif
+
   #ifdef SW_MONITOR_R
   extern void Monitor_R(void);
   #endif
@@ -649,6 +664,15 @@
 
   extern void SemiPinDesignators(void);
   extern void GetGateThreshold(uint8_t Type);
+  #ifdef SW_HFE_SWEEP
+  extern uint8_t BJT_Sweep(void);
+  #endif
+  #ifdef SW_DIODE_CURVE
+  extern uint8_t Diode_Curve(Diode_Type *Diode);
+  #endif
+  #ifdef SW_SCR_CURRENTS
+  extern void SCR_Currents(void);
+  #endif
   extern uint32_t Get_hfe_c(uint8_t Type);
   extern void GetLeakageCurrent(uint8_t Mode);
 
@@ -676,6 +700,15 @@
 #ifndef RESISTOR_C
 
   extern uint16_t SmallResistor(uint8_t ZeroFlag);
+  #ifdef FUNC_R_QUICK
+  extern uint32_t ReadResistor(uint32_t Value);
+  #endif
+  #ifdef SW_R_FAST
+  extern uint8_t QuickReverseResistor(void);
+  #endif
+  #ifdef SW_MONITOR_TRACK
+  extern uint8_t TrackResistor(Resistor_Type *Resistor);
+  #endif
   extern void CheckResistor(void);
   extern uint8_t CheckSingleResistor(uint8_t HighPin, uint8_t LowPin, uint8_t Max);
 
@@ -707,6 +740,10 @@
 
   extern void MeasureCap(uint8_t Probe1, uint8_t Probe2, uint8_t ID);
 
+  #ifdef SW_MONITOR_TRACK
+  extern uint8_t TrackCap(Capacitor_Type *Cap);
+  #endif
+
   #ifdef HW_ADJUST_CAP
   extern uint8_t RefCap(void);
   #endif
@@ -739,6 +776,13 @@
   extern void CheckProbes(uint8_t Probe1, uint8_t Probe2, uint8_t Probe3);
   extern void CheckAlternatives(void);
 
+  #ifdef FUNC_COMP_LEARN
+  extern void ResetCheck(void);
+  extern void SearchComponent(void);
+  extern uint8_t LearnComponent(Learn_Type *Learn);
+  extern uint8_t CheckLearned(Learn_Type *Learn);
+  #endif
+
 #endif
 
 
@@ -753,6 +797,19 @@
   extern uint16_t ReadU_5ms(uint8_t Channel);
   extern uint16_t ReadU_20ms(uint8_t Channel);
 
+  #ifdef FUNC_ADC_CAPTURE
+  extern void ADC_CaptureStart(uint8_t Channel, uint8_t Ref, uint16_t Ticks);
+  extern void ADC_CaptureInterval(uint16_t Ticks);
+  extern uint16_t ADC_CaptureSample(void);
+  extern void ADC_Capture(uint16_t *Buffer, uint8_t Count);
+  extern void ADC_CaptureStop(void);
+  extern uint16_t ADC_CaptureU(uint16_t Value, uint8_t Ref);
+  #endif
+
+  #ifdef SW_LEAKAGE_AUTO
+  extern uint32_t ReadU_Integrated(uint8_t Channel);
+  #endif
+
 #endif
 
 
@@ -39,6 +39,10 @@
 #define MODE_LOW_CURRENT      0b00000001     /* low test current */
 #define MODE_HIGH_CURRENT     0b00000010     /* high test current */
 #define MODE_DELAYED_START    0b00000100     /* delayed start */
+#define MODE_SKIP_SPIKE       0b00001000     /* skip capacitive spikes */
+
+/* window for capacitive spikes (MCU cycles, about 5s) */
+#define SPIKE_CYCLES          (MCU_CYCLES_PER_US * 5)
 
 
 
@@ -126,7 +130,7 @@ Since the range overlaps with the low test current we may use a single table.
  *
  *  requires:
  *  - pointer to time variable (ns)
- *  - measurement mode (low/high current, delayed start)
+ *  - measurement mode (low/high current, delayed start, skip spikes)
  *
  *  returns:
  *  - 3 on success
@@ -249,7 +253,32 @@ uint8_t MeasureInductance(uint32_t *Time, uint8_t Mode)
     Test = TIFR1;                       /* get timer1 flags */
 
     /* end loop if input capture flag is set (= same voltage) */
-    if (Test & (1 << ICF1)) break;
+    if (Test & (1 << ICF1))
+    {
+      #ifdef SW_L_SKIP_SPIKE
+      /*
+       *  A crossing within the first few s might be just a spike caused
+       *  by the capacitance of a large inductor. When the voltage drops
+       *  below the threshold again by the end of the spike window we
+       *  wait for the next crossing. ICR1 keeps the time of the last one.
+       */
+
+      if ((Mode & MODE_SKIP_SPIKE) && (Ticks_H == 0) &&
+          (ICR1 < SPIKE_CYCLES))
+      {
+        while (TCNT1 < SPIKE_CYCLES);   /* wait for end of spike window */
+        TIFR1 = (1 << ICF1);            /* reset Input Capture flag */
+
+        /* comparator output is high when voltage is below threshold */
+        if (ACSR & (1 << ACO))          /* spike */
+        {
+          continue;                     /* wait for next crossing */
+        }
+      }
+      #endif
+
+      break;
+    }
 
     /* detect timer overflow by checking the overflow flag */
     if (Test & (1 << TOV1))
@@ -419,6 +448,8 @@ uint8_t MeasureInductor(Resistor_Type *Resistor)
 
   UpdateProbes2(Resistor->A, Resistor->B);   /* update probes */
 
+  #ifndef SW_L_SKIP_SPIKE
+
   /*
    *  low current & delayed start
    *  - to catch large inductance with capacitive effect
@@ -435,15 +466,22 @@ uint8_t MeasureInductor(Resistor_Type *Resistor)
     }
   }
 
+  #endif
+
 
   /*
    *  low current & immediate start
    *  - to check for high inductance
+   *  - SW_L_SKIP_SPIKE: skips capacitive spikes within the same run
+   *    instead of a separate run with delayed start
    */
 
   if (Test == 0)               /* no valid measurement yet */
   {
     Mode = MODE_LOW_CURRENT;
+    #ifdef SW_L_SKIP_SPIKE
+    Mode |= MODE_SKIP_SPIKE;
+    #endif
     Test = MeasureInductance(&Time1, Mode);
 
     if (Test == 2)             /* inductance too low */
@@ -624,7 +662,7 @@ uint8_t MeasureInductor(Resistor_Type *Resistor)
     while (Value > 100000)    /* re-scale to prevent overflow */
     {
       Value += 5;             /* for automagic rounding */
-      Value /= 10;            /* scale down by 10^1 */
+      Value = Div10(Value);   /* scale down by 10^1 */
       Scale++;                /* increase exponent by 1 */
     }
 
@@ -633,7 +671,7 @@ uint8_t MeasureInductor(Resistor_Type *Resistor)
     while (Value > 100000)    /* re-scale to prevent overflow */
     {
       Value += 5;             /* for automagic rounding */
-      Value /= 10;            /* scale down by 10^1 */
+      Value = Div10(Value);   /* scale down by 10^1 */
       Scale++;                /* increase exponent by 1 */
     }
 
@@ -660,6 +698,8 @@ uint8_t MeasureInductor(Resistor_Type *Resistor)
 #undef MODE_LOW_CURRENT
 #undef MODE_HIGH_CURRENT
 #undef MODE_DELAYED_START
+#undef MODE_SKIP_SPIKE
+#undef SPIKE_CYCLES
 
 
 /* source management */
@@ -900,6 +900,10 @@ void Show_Capacitor(void)
   #if defined (SW_ESR) || defined (SW_OLD_ESR)
   /* measure and display ESR */
   ESR = MeasureESR(MaxCap);        /* measure ESR */
+    #ifdef SW_C_FIT
+    /* fall back to ESR by curve fitting */
+    if ((ESR == UINT16_MAX) && (MaxCap->ESR > 0)) ESR = MaxCap->ESR;
+    #endif
   if (ESR < UINT16_MAX)            /* if successful */
   {
     Display_Space();
@@ -909,6 +913,13 @@ void Show_Capacitor(void)
     /* set data for remote commands */
     Info.Val1 = ESR;               /* copy ESR */
     #endif
+  #elif defined (SW_C_FIT)
+  /* display ESR by curve fitting */
+  if (MaxCap->ESR > 0)             /* got value */
+  {
+    Display_Space();
+    Display_Value(MaxCap->ESR, -2, LCD_CHAR_OMEGA);  /* display ESR */
+  }
   #endif
 
 
@@ -1004,6 +1015,76 @@ void Show_SemiFlybackDiode(uint8_t Anode, uint8_t Cathode)
 
 
 
+#ifdef SW_DIODE_CURVE
+
+/*
+ *  show diode class
+ *
+ *  requires:
+ *  - Class: diode class
+ */
+
+void Show_DiodeClass(uint8_t Class)
+{
+  switch (Class)
+  {
+    case DIODE_SCHOTTKY:
+      Display_EEString(Schottky_str);   /* display: Schottky */
+      break;
+
+    case DIODE_SILICON:
+      Display_EEString(Silicon_str);    /* display: Si */
+      break;
+
+    case DIODE_LED_IR:
+      Display_EEString(LED_IR_str);     /* display: LED IR */
+      break;
+
+    case DIODE_LED_RED:
+      Display_EEString(LED_Red_str);    /* display: LED R */
+      break;
+
+    case DIODE_LED_YG:
+      Display_EEString(LED_YG_str);     /* display: LED Y/G */
+      break;
+
+    case DIODE_LED_BW:
+      Display_EEString(LED_BW_str);     /* display: LED B/W */
+      break;
+  }
+}
+
+
+
+/*
+ *  show Shockley parameters and class of a single diode
+ *
+ *  requires:
+ *  - Diode: pointer to diode
+ */
+
+void Show_DiodeCurve(Diode_Type *Diode)
+{
+  if (Diode_Curve(Diode) == 0) return;  /* no curve */
+
+  /* display n and Rs */
+  Display_NextLine();                   /* move to next line */
+  Display_Char('n');                    /* display: n */
+  Display_Space();
+  Display_FullValue(DiodeFit.n, 2, 0);  /* display n */
+  Display_Space();
+  Display_EEString_Space(R_s_str);      /* display: Rs */
+  Display_Value(DiodeFit.R_s, -2, LCD_CHAR_OMEGA);     /* display Rs */
+
+  /* display class */
+  Display_NextLine();                   /* move to next line */
+  Show_DiodeClass(DiodeFit.Class);
+}
+
+#endif
+
+
+
 /*
  *  show diode(s)
  */
@@ -1283,10 +1364,68 @@ void Show_Diode(void)
     }
     #endif
   }
+
+  #ifdef SW_DIODE_CURVE
+  /* Shockley parameters of a single diode */
+  if (D2 == NULL) Show_DiodeCurve(D1);
+  #endif
 }
 
 
 
+#if defined (SW_HFE_SWEEP) && defined (LCD_GRAPHIC)
+
+/*
+ *  show hFE sweep as mini curve
+ *  - one line per operating point: I_c, hFE and bar
+ *  - runs the sweep
+ */
+
+void Show_HFE_Sweep(void)
+{
+  uint8_t           n = 0;         /* counter */
+  uint8_t           Width;         /* max. bar width */
+  uint16_t          Max = 1;       /* max. hFE */
+  uint32_t          Bar;           /* bar length */
+
+  if (BJT_Sweep() < 2) return;     /* no curve */
+
+  /* get max. hFE */
+  while (n < HFE_Points)
+  {
+    if (HFE_Sweep[n].hFE > Max) Max = HFE_Sweep[n].hFE;
+    n++;
+  }
+
+  /* bar starts at column 13 */
+  Width = UI.CharMax_X - 12;
+
+  n = 0;
+  while (n < HFE_Points)
+  {
+    Display_NextLine();                      /* new line */
+    Display_Value(HFE_Sweep[n].I_c, -9, 'A');     /* display I_c */
+    while (UI.CharPos_X < 8) Display_Space();     /* align */
+    Display_Value2(HFE_Sweep[n].hFE);        /* display hFE */
+    while (UI.CharPos_X < 13) Display_Space();    /* align */
+
+    /* bar: hFE relative to max. hFE */
+    Bar = (uint32_t)HFE_Sweep[n].hFE * Width;
+    Bar /= Max;
+    while (Bar > 0)
+    {
+      Display_Char('=');
+      Bar--;
+    }
+
+    n++;                                     /* next point */
+  }
+}
+
+#endif
+
+
+
 /*
  *  show BJT
  */
@@ -1305,6 +1444,9 @@ void Show_BJT(void)
   #endif
   uint16_t          V_BE = 0;      /* V_BE */
   int16_t           Slope;         /* slope of forward voltage */
+  #if defined (SW_HFE_SWEEP) && defined (LCD_GRAPHIC)
+  uint8_t           Flag = 0;      /* B-E resistor flag */
+  #endif
 
   /*
    *  Mapping for Semi structure:
@@ -1423,6 +1565,9 @@ void Show_BJT(void)
   if (CheckSingleResistor(BE_C, BE_A, 25) == 1)   /* found B-E resistor */
   {
     Display_NextLine();            /* next line (#3) */
+    #if defined (SW_HFE_SWEEP) && defined (LCD_GRAPHIC)
+    Flag = 1;                      /* B-E resistor */
+    #endif
     #ifdef UI_PROBE_COLORS
       Show_SingleResistor(Semi.A, Semi.C, 1);     /* show resistor */
     #else
@@ -1630,6 +1775,19 @@ void Show_BJT(void)
     }
   }
   #endif
+
+
+  #if defined (SW_HFE_SWEEP) && defined (LCD_GRAPHIC)
+  /*
+   *  hFE sweep: mini curve
+   *  - B-E resistor renders values useless
+   */
+
+  if (Flag == 0)                        /* no B-E resistor */
+  {
+    Show_HFE_Sweep();                   /* show curve */
+  }
+  #endif
 }
 
 
@@ -1955,6 +2113,10 @@ void Show_ThyristorTriac(void)
    *  U_1 - V_GT (mV)
    */
 
+  #ifdef SW_SCR_CURRENTS
+  SCR_Currents();                       /* measure currents */
+  #endif
+
   /* display component type in line #1 and pinout in line #2 */
   if (Check.Found == COMP_THYRISTOR)    /* SCR */
   {
@@ -1986,6 +2148,25 @@ void Show_ThyristorTriac(void)
     Display_NL_EEString_Space(V_GT_str);     /* display: V_GT */
     Display_Value(Semi.U_1, -3, 'V');        /* display V_GT in mV */
   }
+
+  #ifdef SW_SCR_CURRENTS
+  /* show I_GT, I_L and I_H */
+  if (SCR.I_GT > 0)                /* show if not zero */
+  {
+    Display_NL_EEString_Space(I_GT_str);     /* display: I_GT */
+    Display_Value(SCR.I_GT, -9, 'A');        /* display I_GT in nA */
+  }
+  if (SCR.I_L > 0)                 /* show if not zero */
+  {
+    Display_NL_EEString_Space(I_Latch_str);  /* display: I_L */
+    Display_Value(SCR.I_L, -9, 'A');         /* display I_L in nA */
+  }
+  if (SCR.I_H > 0)                 /* show if not zero */
+  {
+    Display_NL_EEString_Space(I_Hold_str);   /* display: I_H */
+    Display_Value(SCR.I_H, -9, 'A');         /* display I_H in nA */
+  }
+  #endif
 }
 
 
@@ -2788,6 +2969,9 @@ int main(void)
   /* default offsets and values */
   Cfg.Samples = ADC_SAMPLES;            /* number of ADC samples */
   Cfg.AutoScale = 1;                    /* enable ADC auto scaling */
+  #ifdef SW_ESR_GATETIME
+  Cfg.ESR_Gate = ESR_GATE;              /* gate time for ESR measurement */
+  #endif
   Cfg.Ref = 1;                          /* no ADC reference set yet */
   Cfg.Vcc = UREF_VCC;                   /* voltage of Vcc */
 
@@ -2971,6 +3155,15 @@ cycle_start:
   }
   #endif
 
+  #ifdef SW_REPEAT_TYPE
+  /* check for type and pinout of last component first */
+  if (CheckLearned(&LastComp))     /* same component */
+  {
+    goto show_component;           /* skip all other checks */
+  }
+  ResetCheck();                    /* reset detection */
+  #endif
+
   /* check all 6 combinations of the 3 probes */
   CheckProbes(PROBE_1, PROBE_2, PROBE_3);
   CheckProbes(PROBE_2, PROBE_1, PROBE_3);
@@ -2982,6 +3175,11 @@ cycle_start:
   CheckAlternatives();             /* process alternatives */
   SemiPinDesignators();            /* manage semi pin designators */
 
+  #ifdef SW_REPEAT_TYPE
+  /* remember type and pinout for next cycle */
+  LearnComponent(&LastComp);
+  #endif
+
   /* if component might be a capacitor */
   if ((Check.Found == COMP_NONE) ||
       (Check.Found == COMP_RESISTOR))
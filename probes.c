@@ -211,6 +211,67 @@ uint8_t ShortedProbes(void)
 
 
 
+/*
+ *  predict time for discharging to a threshold
+ *  - assumes exponential decay: U(t) = U_0 * e^(-t/tau)
+ *    i.e. the voltage drops by the same ratio in each time interval
+ *  - extrapolates the ratio U_2/U_1 until the threshold is reached
+ *    and interpolates the last interval linearly
+ *
+ *  requires:
+ *  - U_1: former voltage (mV)
+ *  - U_2: current voltage (mV)
+ *  - U_th: threshold voltage (mV)
+ *  - Time: time between U_1 and U_2 (ms)
+ *
+ *  returns:
+ *  - predicted time (ms), limited to 1s
+ *  - 0 if no prediction is possible
+ */
+
+uint16_t DischargeTime(uint16_t U_1, uint16_t U_2, uint16_t U_th, uint16_t Time)
+{
+  uint16_t          Wait = 0;      /* return value */
+  uint32_t          U;             /* extrapolated voltage */
+  uint32_t          U_prev = 0;    /* former extrapolated voltage */
+  uint32_t          Value;         /* temporary value */
+
+  #define DISCHARGE_WAIT_MAX   1000     /* limit for prediction (ms) */
+
+  /* we need some decay */
+  if ((U_2 >= U_1) || (U_2 <= U_th) || (Time == 0)) return 0;
+
+  /* decay has to exceed ADC noise (about 1/64 or 4mV) */
+  if ((U_1 - U_2) < 4) return 0;
+  if ((U_1 - U_2) < (U_1 / 64)) return 0;
+
+  U = U_2;
+  while (U > U_th)            /* until threshold is reached */
+  {
+    if (Wait >= DISCHARGE_WAIT_MAX)     /* limit */
+    {
+      return DISCHARGE_WAIT_MAX;
+    }
+
+    U_prev = U;               /* save voltage */
+    U *= U_2;                 /* decay by ratio U_2/U_1 */
+    U /= U_1;
+    Wait += Time;             /* another interval */
+  }
+
+  /* we overshot: subtract time for U_th - U */
+  Value = U_th - U;           /* overshoot */
+  Value *= Time;
+  Value /= U_prev - U;        /* voltage drop of last interval */
+  Wait -= (uint16_t)Value;
+
+  #undef DISCHARGE_WAIT_MAX
+
+  return Wait;
+}
+
+
+
 #if defined (SW_ESR) || defined (SW_OLD_ESR)
 
 /*
@@ -226,6 +287,8 @@ void DischargeCap(uint8_t Probe1, uint8_t Probe2)
   uint8_t           n;             /* counter */
   uint16_t          U_1;           /* voltage #1 */
   uint16_t          U_2;           /* voltage #2 */
+  uint16_t          Wait;          /* time to wait (ms) */
+  uint16_t          Total = 0;     /* total waiting time (ms) */
 
   /* probes: set to safe mode */
   ADC_DDR = 0;
@@ -257,39 +320,61 @@ void DischargeCap(uint8_t Probe1, uint8_t Probe2)
 
   /*
    *  discharge cap to voltage below 40mV
+   *  - predict the time for reaching the next threshold (400mV for
+   *    direct pull-down, 40mV for discharged) based on the decay
+   *    since the last reading and sleep that time in one go
+   *  - aim a bit below the threshold to prevent a tail of short
+   *    sleeps
    */
 
   /* discharge positive side via Rl */
   ADC_DDR = Probes.Pin_1;          /* pull down probe-1 directly */
   R_DDR = Probes.Rl_2;             /* pull down probe-2 via Rl */
 
+  U_1 = ReadU(Probes.Ch_2);        /* get voltage at probe-2 */
+  Wait = 20;                       /* short interval for first prediction */
   n = 1;
 
   while (n)                        /* processing loop */
   {
-    U_1 = ReadU(Probes.Ch_2);      /* get voltage at probe-2 */
-
     if (U_1 < 400)                 /* below 400mV */
     {
-      ADC_DDR |= Probes.Pin_2;     /* also pull down probe-2 directly */
+      if (! (ADC_DDR & Probes.Pin_2))   /* not pulled down directly yet */
+      {
+        ADC_DDR |= Probes.Pin_2;   /* also pull down probe-2 directly */
+        Wait = 10;                 /* very fast discharge */
+      }
     }
 
     if (U_1 < 40)                  /* discharged < 40mV */
     {
       n = 0;                       /* end loop */
     }
-    else                           /* not discharged yet */
+    else if (Total > 5000)         /* timeout (5s) */
     {
-      n++;                         /* another cycle */
+      n = 0;                       /* end loop */
+    }
+    else                           /* keep discharging */
+    {
+      MilliSleep(Wait);            /* wait */
+      Total += Wait;
 
-      if (n > 50)                  /* timeout (5s) */
+      U_2 = ReadU(Probes.Ch_2);    /* get voltage at probe-2 */
+
+      /* predict time for next threshold */
+      if (ADC_DDR & Probes.Pin_2)  /* pulled down directly */
       {
-        n = 0;                     /* end loop */
+        Wait = DischargeTime(U_1, U_2, 30, Wait);
       }
-      else                         /* keep discharging */
+      else                         /* pulled down via Rl */
       {
-        MilliSleep(100);           /* wait */
+        Wait = DischargeTime(U_1, U_2, 350, Wait);
       }
+
+      if (Wait == 0) Wait = 100;   /* no prediction: default interval */
+      else if (Wait < 10) Wait = 10;    /* minimum interval */
+
+      U_1 = U_2;                   /* update voltage */
     }
   }
 
@@ -317,6 +402,9 @@ void DischargeProbes(void)
   uint8_t           Channel;            /* ADC MUX channel */
   uint16_t          U_c;                /* current voltage */
   uint16_t          U_old[3];           /* old voltages */
+  uint16_t          Age[3];             /* age of old voltages (ms) */
+  uint16_t          Wait;               /* time to wait (ms) */
+  uint16_t          Temp;               /* temporary value */
 
 
   /*
@@ -336,6 +424,9 @@ void DischargeProbes(void)
   U_old[0] = ReadU(TP1);
   U_old[1] = ReadU(TP2);
   U_old[2] = ReadU(TP3);
+  Age[0] = 0;
+  Age[1] = 0;
+  Age[2] = 0;
 
   /*
    *  try to discharge probes
@@ -352,6 +443,10 @@ void DischargeProbes(void)
    *  - The protection relay option comes in two variants, i.e. probes shorted
    *    directly or via resistors. So we dont't use it here to keep things
    *    simple.
+   *  - Based on the exponential decay we predict when a probe will reach
+   *    the next threshold (400mV or discharged). We sleep the predicted
+   *    time (max. 500ms) in one step and check the same probe again,
+   *    instead of polling it every 50ms.
    */
 
   /* reset variables */
@@ -371,10 +466,23 @@ void DischargeProbes(void)
     /* get voltage at probe */
     Channel = DATA_read_byte(&Channel_table[ID]);    /* update ADC channel */
     U_c = ReadU(Channel);                            /* get voltage */
+    Wait = 0;                           /* no prediction yet */
 
     if (U_c < U_old[ID])                /* voltage decreased */
     {
+      /* predict time for next threshold */
+      if (ADC_DDR & DATA_read_byte(&Pin_table[ID]))  /* pulled down directly */
+      {
+        Temp = CAP_DISCHARGED;
+      }
+      else                                           /* pulled down via Rh/Rl */
+      {
+        Temp = 400;
+      }
+      Wait = DischargeTime(U_old[ID], U_c, Temp, Age[ID]);
+
       U_old[ID] = U_c;                  /* update old value */
+      Age[ID] = 0;                      /* reset age */
 
       /* adapt timeout based on discharge rate */
       if ((Limit - Counter) < 20)
@@ -399,8 +507,13 @@ void DischargeProbes(void)
     }
     else if (U_c < 400)                 /* extra pull-down (< 400mV) */
     {
-      /* it's safe now to pull down probe pin directly */
-      ADC_DDR |= DATA_read_byte(&Pin_table[ID]);
+      Temp = DATA_read_byte(&Pin_table[ID]);
+      if (! (ADC_DDR & Temp))           /* not pulled down directly yet */
+      {
+        /* it's safe now to pull down probe pin directly */
+        ADC_DDR |= Temp;
+        Wait = 10;                      /* expect fast discharge */
+      }
     }
 
     if (Flags == 0b00000111)            /* all probes discharged */
@@ -425,8 +538,26 @@ void DischargeProbes(void)
     }
     else                                /* go for another round */
     {
+      if ((Wait > 0) && !(Flags & (1 << ID)))
+      {
+        /* sleep until probe is predicted to reach threshold */
+        if (Wait < 2) Wait = 2;         /* minimum time */
+        if (Wait > 500) Wait = 500;     /* maximum time */
+        ID--;                           /* check same probe again */
+        /* ID 0 wraps around to 255 and is incremented to 0 again */
+      }
+      else                              /* no prediction */
+      {
+        Wait = 50;                      /* regular check */
+      }
+
+      /* update age of old voltages */
+      Age[0] += Wait;
+      Age[1] += Wait;
+      Age[2] += Wait;
+
       wdt_reset();                      /* reset watchdog */
-      MilliSleep(50);                   /* wait for 50ms */
+      MilliSleep(Wait);                 /* wait */
     }
   }
 
@@ -604,6 +735,9 @@ uint8_t GetENormValue(uint32_t Value, int8_t Scale, uint8_t E_Series, uint8_t To
   uint16_t          *Table;             /* pointer to table */
   uint8_t           Index;              /* table index */
   uint8_t           n;                  /* counter */
+  uint8_t           Low;                /* lower limit of search range */
+  uint8_t           Mid;                /* middle of search range */
+  uint8_t           Slot;               /* cache slot */
   uint16_t          Norm;               /* norm value */
   uint16_t          LowVal = 0;         /* lower norm value */
   uint16_t          HighVal = 0;        /* higher norm value */
@@ -636,6 +770,7 @@ uint8_t GetENormValue(uint32_t Value, int8_t Scale, uint8_t E_Series, uint8_t To
     case E6:                                /* E6 */
       Table = (uint16_t *)&E6_table[0];     /* pointer to table */
       Index = NUM_E6;                       /* 6 values */
+      Slot = 0;                             /* cache slot */
       break;
     #endif
 
@@ -643,6 +778,7 @@ uint8_t GetENormValue(uint32_t Value, int8_t Scale, uint8_t E_Series, uint8_t To
     case E12:                                /* E12 */
       Table = (uint16_t *)&E12_table[0];     /* pointer to table */
       Index = NUM_E12;                       /* 12 values */
+      Slot = 1;                              /* cache slot */
       break;
     #endif
 
@@ -650,6 +786,7 @@ uint8_t GetENormValue(uint32_t Value, int8_t Scale, uint8_t E_Series, uint8_t To
     case E24:                                /* E24 */
       Table = (uint16_t *)&E24_table[0];     /* pointer to table */
       Index = NUM_E24;                       /* 24 values */
+      Slot = 2;                              /* cache slot */
       break;
     #endif
 
@@ -657,6 +794,7 @@ uint8_t GetENormValue(uint32_t Value, int8_t Scale, uint8_t E_Series, uint8_t To
     case E96:                                /* E96 */
       Table = (uint16_t *)&E96_table[0];     /* pointer to table */
       Index = NUM_E96;                       /* 96 values */
+      Slot = 3;                              /* cache slot */
       break;
     #endif
 
@@ -674,7 +812,7 @@ uint8_t GetENormValue(uint32_t Value, int8_t Scale, uint8_t E_Series, uint8_t To
   while (Value >= 100000)     /* upper limit */
   {
     /* todo: round? */
-    Value /= 10;              /* /10 */
+    Value = Div10(Value);     /* /10 */
     Scale++;                  /* +1 */
   }
 
@@ -695,7 +833,7 @@ uint8_t GetENormValue(uint32_t Value, int8_t Scale, uint8_t E_Series, uint8_t To
   while (Value >= 1000)       /* upper limit */
   {
     /* todo: round? */
-    Value /= 10;              /* /10 */
+    Value = Div10(Value);     /* /10 */
     Scale++;                  /* increase multiplier */
   }
 
@@ -704,36 +842,57 @@ uint8_t GetENormValue(uint32_t Value, int8_t Scale, uint8_t E_Series, uint8_t To
 
   /*
    *  get lower and higher norm value from table
+   *  - binary search for first norm value >= value
+   *  - cache: same value as last lookup for this E series
    */
 
-  n = 0;                      /* reset counter */
-
-  while (n < Index)           /* loop through table */
+  if (ENorm_Value[Slot] == (uint16_t)Value)     /* cache hit */
   {
-    Norm = DATA_read_word(Table);  /* read norm value */
+    n = ENorm_Index[Slot];         /* take cached index */
+  }
+  else                             /* cache miss */
+  {
+    Low = 0;                       /* first element */
+    n = Index;                     /* behind last element */
 
-    if (Norm < (uint16_t)Value)    /* norm value lower */
-    {
-      LowVal = Norm;               /* update lower norm value */
-      #ifdef FUNC_EIA96
-      LowIndex = n;                /* update index number */
-      #endif
-    }
-    else                           /* norm value higher */
+    while (Low < n)                /* search range not empty */
     {
-      HighVal = Norm;              /* save higher norm value */
-      #ifdef FUNC_EIA96
-      HighIndex = n;               /* save index number */
-      #endif
-      break;                       /* end loop */
+      Mid = (Low + n) / 2;         /* middle of range */
+      Norm = DATA_read_word(Table + Mid);  /* read norm value */
+
+      if (Norm < (uint16_t)Value)  /* norm value lower */
+      {
+        Low = Mid + 1;             /* search upper half */
+      }
+      else                         /* norm value higher or same */
+      {
+        n = Mid;                   /* search lower half */
+      }
     }
 
-    Table++;                       /* next element */
-    n++;                           /* next one */
+    /* update cache */
+    ENorm_Value[Slot] = (uint16_t)Value;
+    ENorm_Index[Slot] = n;
+  }
+
+  /* lower norm value */
+  if (n > 0)                       /* not first element */
+  {
+    LowVal = DATA_read_word(Table + n - 1);
+    #ifdef FUNC_EIA96
+    LowIndex = n - 1;              /* index number */
+    #endif
   }
 
-  /* manage table index overflow */
-  if (n == Index)                  /* reached last element */
+  /* higher norm value */
+  if (n < Index)                   /* within table */
+  {
+    HighVal = DATA_read_word(Table + n);
+    #ifdef FUNC_EIA96
+    HighIndex = n;                 /* index number */
+    #endif
+  }
+  else                             /* behind last element */
   {
     /* higher norm value is 1000 (100 and multiplier + 1) */
     HighVal = 1000;
@@ -1178,6 +1337,244 @@ void CheckAlternatives(void)
 
 
 
+#ifdef FUNC_COMP_LEARN
+
+/* ************************************************************************
+ *   learned components (fast re-test)
+ * ************************************************************************ */
+
+
+/*
+ *  reset component detection
+ */
+
+void ResetCheck(void)
+{
+  Check.Found = COMP_NONE;         /* no component */
+  Check.Type = 0;                  /* reset type flags */
+  Check.Done = DONE_NONE;          /* no transistor */
+  Check.AltFound = COMP_NONE;      /* no alternative component */
+  Check.Diodes = 0;                /* reset diode counter */
+  Check.Resistors = 0;             /* reset resistor counter */
+  Semi.Flags = 0;                  /* reset flags */
+  Semi.U_1 = 0;                    /* reset values */
+  Semi.U_2 = 0;
+  Semi.U_3 = 0;
+  Semi.F_1 = 0;
+  #ifdef SW_REVERSE_HFE
+  Semi.F_2 = 0;
+  #endif
+  Semi.I_value = 0;
+  AltSemi.U_1 = 0;
+  AltSemi.U_2 = 0;
+}
+
+
+
+/*
+ *  search component: check all 6 combinations of the 3 probes
+ *  - same as normal probing but without caps and Zener check
+ */
+
+void SearchComponent(void)
+{
+  ResetCheck();                    /* reset detection */
+
+  DischargeProbes();               /* try to discharge DUT */
+  if (Check.Found == COMP_ERROR) return;     /* discharge failed */
+
+  CheckProbes(PROBE_1, PROBE_2, PROBE_3);
+  CheckProbes(PROBE_2, PROBE_1, PROBE_3);
+  CheckProbes(PROBE_1, PROBE_3, PROBE_2);
+  CheckProbes(PROBE_3, PROBE_1, PROBE_2);
+  CheckProbes(PROBE_2, PROBE_3, PROBE_1);
+  CheckProbes(PROBE_3, PROBE_2, PROBE_1);
+
+  CheckAlternatives();             /* process alternatives */
+  SemiPinDesignators();            /* manage semi pin designators */
+}
+
+
+
+/*
+ *  learn type and pinout of the detected component
+ *  - supports BJTs, FETs, IGBTs and single diodes
+ *
+ *  requires:
+ *  - Learn: pointer to learned component
+ *
+ *  returns:
+ *  - 1 if component is supported
+ *  - 0 if not
+ */
+
+uint8_t LearnComponent(Learn_Type *Learn)
+{
+  uint8_t           Flag = 1;      /* return value */
+
+  Learn->Found = Check.Found;      /* component */
+  Learn->Type = Check.Type;        /* sub-type */
+
+  switch (Check.Found)
+  {
+    case COMP_BJT:            /* BJT */
+    case COMP_FET:            /* FET */
+    case COMP_IGBT:           /* IGBT */
+      Learn->A = Semi.A;           /* base/gate */
+      Learn->B = Semi.B;           /* collector/drain */
+      Learn->C = Semi.C;           /* emitter/source */
+      break;
+
+    case COMP_DIODE:          /* diode */
+      if (Check.Diodes == 1)       /* single diode */
+      {
+        Learn->A = Diodes[0].A;    /* anode */
+        Learn->B = Diodes[0].C;    /* cathode */
+        /* remaining probe */
+        Learn->C = (PROBE_1 + PROBE_2 + PROBE_3) - Diodes[0].A - Diodes[0].C;
+        break;
+      }
+      /* fall through */
+
+    default:                  /* unsupported */
+      Learn->Found = COMP_NONE;
+      Flag = 0;
+      break;
+  }
+
+  return Flag;
+}
+
+
+
+/*
+ *  check for a learned component
+ *  - runs only the probe combinations needed for the learned type and
+ *    pinout instead of all 6
+ *  - diode: both directions plus a check that the third probe is
+ *    isolated, to reject BJTs, dual and anti-parallel diodes
+ *  - BJT: C-E in both directions (reverse hFE and freewheeling diode)
+ *    plus the B-E junction
+ *
+ *  requires:
+ *  - Learn: pointer to learned component
+ *  - reset detection and discharged DUT (done by caller)
+ *
+ *  returns:
+ *  - 1 if the same component with the same pinout was found
+ *  - 0 on mismatch or no component
+ */
+
+uint8_t CheckLearned(Learn_Type *Learn)
+{
+  uint8_t           Flag = 0;      /* return value */
+  uint16_t          U_1 = 0;       /* voltage across Rl #1 */
+  uint16_t          U_2 = 0;       /* voltage across Rl #2 */
+
+  /* local constants */
+  #define ISO_LEVEL         100    /* max. voltage across Rl (mV) */
+
+  if (Learn->Found == COMP_NONE) return Flag;     /* nothing learned */
+
+  if (Learn->Found == COMP_DIODE)  /* diode */
+  {
+    /* anode -- cathode and cathode -- anode */
+    CheckProbes(Learn->A, Learn->B, Learn->C);
+    CheckProbes(Learn->B, Learn->A, Learn->C);
+
+    /*
+     *  check if third probe is isolated
+     *  - anode and cathode at the same level (diode doesn't conduct)
+     *  - probe-3 pulled up via Rl with anode and cathode at Gnd, and
+     *    pulled down via Rl with anode and cathode at Vcc
+     *  - any junction or low resistance to probe-3 causes a current
+     */
+
+    UpdateProbes(Learn->A, Learn->B, Learn->C);    /* update bitmasks */
+
+    /* set probes: Gnd -- probe-1 / Gnd -- probe-2 / probe-3 -- Rl -- Vcc */
+    ADC_PORT = 0;                            /* set ADC port low */
+    ADC_DDR = Probes.Pin_1 | Probes.Pin_2;   /* pull down probe-1 and probe-2 */
+    R_PORT = Probes.Rl_3;                    /* pull up probe-3 via Rl */
+    R_DDR = Probes.Rl_3;                     /* enable Rl for probe-3 */
+    U_1 = ReadU_5ms(Probes.Ch_3);            /* get voltage at probe-3 */
+    if (U_1 < Cfg.Vcc) U_1 = Cfg.Vcc - U_1;  /* voltage across Rl */
+    else U_1 = 0;
+
+    /* set probes: Vcc -- probe-1 / Vcc -- probe-2 / probe-3 -- Rl -- Gnd */
+    ADC_PORT = Probes.Pin_1 | Probes.Pin_2;  /* pull up probe-1 and probe-2 */
+    R_PORT = 0;                              /* pull down probe-3 via Rl */
+    U_2 = ReadU_5ms(Probes.Ch_3);            /* get voltage across Rl */
+
+    /* reset probes */
+    ADC_DDR = 0;                     /* set ADC port to HiZ mode */
+    ADC_PORT = 0;                    /* set ADC port low */
+    R_DDR = 0;                       /* set resistor port to HiZ mode */
+    R_PORT = 0;                      /* set resistor port low */
+  }
+  else                             /* BJT, FET or IGBT */
+  {
+    /*
+     *  we assume (pin A = B/G, pin B = C/D, pin C = E/S):
+     *  - NPN/n-channel: probe-1 = C/D / probe-2 = E/S / probe-3 = B/G
+     *  - PNP/p-channel: probe-1 = E/S / probe-2 = C/D / probe-3 = B/G
+     *  - TYPE_NPN and TYPE_N_CHANNEL share the same bit
+     */
+
+    if (Learn->Type & TYPE_NPN)    /* NPN or n-channel */
+    {
+      CheckProbes(Learn->B, Learn->C, Learn->A);
+      /* reversed C/E, freewheeling or body diode: E/S -- C/D */
+      CheckProbes(Learn->C, Learn->B, Learn->A);
+      /* B-E junction */
+      if (Learn->Found == COMP_BJT) CheckProbes(Learn->A, Learn->C, Learn->B);
+    }
+    else                           /* PNP or p-channel */
+    {
+      CheckProbes(Learn->C, Learn->B, Learn->A);
+      /* reversed C/E, freewheeling or body diode: C/D -- E/S */
+      CheckProbes(Learn->B, Learn->C, Learn->A);
+      /* E-B junction */
+      if (Learn->Found == COMP_BJT) CheckProbes(Learn->C, Learn->A, Learn->B);
+    }
+
+    CheckAlternatives();           /* process alternatives */
+    SemiPinDesignators();          /* manage semi pin designators */
+  }
+
+
+  /*
+   *  compare with learned component
+   */
+
+  if ((Check.Found == Learn->Found) && (Check.Type == Learn->Type))
+  {
+    if (Check.Found == COMP_DIODE)      /* diode */
+    {
+      /* single diode and isolated third probe */
+      if ((Check.Diodes == 1) &&
+          (Diodes[0].A == Learn->A) && (Diodes[0].C == Learn->B) &&
+          (U_1 <= ISO_LEVEL) && (U_2 <= ISO_LEVEL))
+      {
+        Flag = 1;                       /* match */
+      }
+    }
+    else if ((Semi.A == Learn->A) && (Semi.B == Learn->B) && (Semi.C == Learn->C))
+    {
+      Flag = 1;                         /* match */
+    }
+  }
+
+  /* clean up local constants */
+  #undef ISO_LEVEL
+
+  return Flag;
+}
+
+#endif
+
+
+
 /* ************************************************************************
  *   clean-up of local constants
  * ************************************************************************ */
@@ -209,6 +209,174 @@ uint16_t SmallResistor(uint8_t ZeroFlag)
 
 
 
+#ifdef FUNC_R_QUICK
+
+/*
+ *  measure resistor with a single voltage divider
+ *  - probe-1: Vcc side, probe-2: Gnd side
+ *  - uses Rl or Rh based on the expected value
+ *  - doesn't cover small resistors (< 10 Ohms), since they need the
+ *    special handling for probe contact issues
+ *
+ *  requires:
+ *  - Value: expected resistance (in 0.1 Ohms)
+ *
+ *  returns:
+ *  - resistance in 0.1 Ohms
+ *  - 0 on any problem
+ */
+
+uint32_t ReadResistor(uint32_t Value)
+{
+  uint16_t          U_R;           /* voltage at DUT (probe-1) */
+  uint16_t          U_Ri;          /* voltage at internal R of MCU */
+
+  /* set probes: Gnd -- probe-2 / probe-1 -- HiZ */
+  ADC_PORT = 0;                         /* set ADC port to low */
+  ADC_DDR = Probes.Pin_2;               /* pull down probe-2 directly */
+  R_PORT = 0;                           /* set resistor port to low */
+
+  if (Value < 195000)                   /* R < 19.5k: use Rl */
+  {
+    /* set probes: Gnd -- probe-2 / probe-1 -- Rl -- Vcc */
+    R_DDR = Probes.Rl_1;                /* enable Rl for probe-1 */
+    R_PORT = Probes.Rl_1;               /* pull up probe-1 via Rl */
+    U_Ri = ReadU(Probes.Ch_2);          /* get voltage at internal R of MCU */
+    U_R = ReadU(Probes.Ch_1);           /* get voltage at Rl pulled up */
+
+    if ((U_R >= Cfg.Vcc) || (U_R < U_Ri)) return 0;   /* sanity check */
+
+    /* R = (Rl + RiH) * (U_Rl_H - U_Ri_L) / (Vcc - U_Rl_H) */
+    Value = (R_LOW * 10) + NV.RiH;      /* Rl + RiH in 0.1 Ohm */
+    Value *= (U_R - U_Ri);
+    Value /= (Cfg.Vcc - U_R);
+  }
+  else                                  /* R >= 19.5k: use Rh */
+  {
+    /* set probes: Gnd -- probe-2 / probe-1 -- Rh -- Vcc */
+    R_DDR = Probes.Rh_1;                /* enable Rh for probe-1 */
+    R_PORT = Probes.Rh_1;               /* pull up probe-1 via Rh */
+    U_R = ReadU_5ms(Probes.Ch_1);       /* get voltage at Rh pulled up */
+
+    if (U_R >= Cfg.Vcc) return 0;       /* sanity check */
+
+    /* R = Rh * U_Rh_H / (Vcc - U_Rh_H) */
+    Value = R_HIGH * U_R;
+    Value /= (Cfg.Vcc - U_R);
+    Value += RH_OFFSET;                 /* add offset value for measurement with Rh */
+    Value *= 10;                        /* upscale to 0.1 Ohms */
+  }
+
+  return Value;
+}
+
+#endif
+
+
+
+#ifdef SW_R_FAST
+
+/*
+ *  quick check of a known resistor in reverse direction
+ *  - the resistor has been measured already with probe-1 and probe-2
+ *    swapped (pin facing Gnd is probe-1 now)
+ *  - skips the plausibility checks of CheckResistor() for this direction
+ *  - doesn't cover small resistors (< 10 Ohms), since they need the
+ *    special handling of SmallResistor()
+ *
+ *  returns:
+ *  - 1 if resistance matches within 5%
+ *  - 0 if there's no match or check isn't applicable
+ */
+
+uint8_t QuickReverseResistor(void)
+{
+  uint8_t           Flag = 0;      /* return value */
+  uint8_t           n = 0;         /* counter */
+  Resistor_Type     *Resistor;     /* pointer to resistor */
+  uint32_t          Value;         /* resistance */
+  uint32_t          Temp;          /* tolerance */
+
+  /* search for resistor measured in other direction */
+  while (n < Check.Resistors)
+  {
+    Resistor = &Resistors[n];      /* pointer to element */
+
+    if ((Resistor->A == Probes.ID_1) && (Resistor->B == Probes.ID_2))
+    {
+      break;                       /* found it */
+    }
+
+    n++;                           /* next one */
+  }
+
+  if (n == Check.Resistors) return Flag;     /* not found */
+  if (Resistor->Scale != -1) return Flag;    /* not in 0.1 Ohms */
+  if (Resistor->Value < 100) return Flag;    /* < 10 Ohms */
+
+  Value = ReadResistor(Resistor->Value);     /* measure */
+
+  /* check if value matches within 5% */
+  Temp = Resistor->Value / 20;          /* 5% */
+  if ((Value >= (Resistor->Value - Temp)) &&
+      (Value <= (Resistor->Value + Temp)))
+  {
+    Check.Found = COMP_RESISTOR;        /* confirmed resistor */
+    Flag = 1;
+  }
+
+  return Flag;
+}
+
+#endif
+
+
+
+#ifdef SW_MONITOR_TRACK
+
+/*
+ *  track a known resistor (R/L monitors)
+ *  - re-measures resistor with current probe setup (probe-1 and probe-2
+ *    have to match the resistor's pins)
+ *  - skips all plausibility checks of CheckResistor()
+ *  - updates resistor's value if the new value is within the tracking
+ *    window
+ *
+ *  requires:
+ *  - Resistor: pointer to resistor data
+ *
+ *  returns:
+ *  - 1 if new value is within tracking window
+ *  - 0 if not or when tracking isn't applicable
+ */
+
+uint8_t TrackResistor(Resistor_Type *Resistor)
+{
+  uint8_t           Flag = 0;      /* return value */
+  uint32_t          Value;         /* resistance */
+  uint32_t          Window;        /* tracking window */
+
+  if (Resistor->Scale != -1) return Flag;    /* not in 0.1 Ohms */
+  if (Resistor->Value < 100) return Flag;    /* < 10 Ohms */
+
+  Value = ReadResistor(Resistor->Value);     /* measure */
+
+  /* check tracking window */
+  Window = Resistor->Value / TRACK_WINDOW;
+  if ((Value >= (Resistor->Value - Window)) &&
+      (Value <= (Resistor->Value + Window)))
+  {
+    Resistor->Value = Value;            /* update value */
+    Flag = 1;
+  }
+
+  return Flag;
+}
+
+#endif
+
+
+
 /*
  *  check for resistor
  */
@@ -231,9 +399,24 @@ void CheckResistor(void)
   uint16_t          U_Ri_L;        /* voltage at Ri pulled down */
   uint16_t          U_Rh_H;        /* voltage at Rh pulled up */
   uint16_t          U_Rh_L;        /* voltage ar Rh pulled down */
+  #ifdef SW_R_FAST
+  uint8_t           Samples;       /* number of ADC samples */
+  uint8_t           Fast = 0;      /* fast path */
+  #endif
+
+  #ifdef SW_R_FAST
+    #define R_FAST_SAMPLES     5   /* ADC samples for estimates */
+  #endif
 
   wdt_reset();                     /* reset watchdog */
 
+  #ifdef SW_R_FAST
+  /* known resistor in reverse direction: quick check */
+  if (QuickReverseResistor()) return;
+
+  Samples = Cfg.Samples;           /* save number of ADC samples */
+  #endif
+
   #if 0
   DischargeProbes();                         /* try to discharge probes */
   if (Check.Found == COMP_ERROR) return;     /* skip on error */
@@ -284,17 +467,43 @@ void CheckResistor(void)
   /* set probes: Gnd -- probe-2 / Gnd -- Rh -- probe-1 */
   R_PORT = 0;                           /* set resistor port low */
   R_DDR = Probes.Rh_1;                  /* pull down probe-1 via Rh */
+  #ifdef SW_R_FAST
+  Cfg.Samples = R_FAST_SAMPLES;         /* estimate is sufficient */
+  #endif
   U_Rh_L = ReadU_5ms(Probes.Ch_1);      /* get voltage at probe-1 */
+  #ifdef SW_R_FAST
+  Cfg.Samples = Samples;                /* restore number of samples */
+  #endif
 
   /* we got a resistor if the voltage is near Gnd */
   if (U_Rh_L <= 20)
   {
+    #ifdef SW_R_FAST
+    /*
+     *  estimate range via U_Rl_H
+     *  - R < 19.5k: DUT was discharged via Rh within 5ms, so we don't
+     *    have to wait for settling and U_Rh_H is needed just for the
+     *    voltage breakdown check
+     */
+
+    if (U_Rl_H <= (Cfg.Vcc - 169)) Fast = 1;
+    #endif
+
     /*
      *  get voltage for Rh pulled up
      */
 
     /* set probes: Gnd -- probe-2 / probe-1 -- Rh -- Vcc */
     R_PORT = Probes.Rh_1;                    /* pull up probe-1 via Rh */
+    #ifdef SW_R_FAST
+    if (Fast)                                /* low R */
+    {
+      Cfg.Samples = R_FAST_SAMPLES;          /* estimate is sufficient */
+      U_Rh_H = ReadU(Probes.Ch_1);           /* get voltage at Rh pulled up */
+      Cfg.Samples = Samples;                 /* restore number of samples */
+    }
+    else
+    #endif
     U_Rh_H = ReadU_5ms(Probes.Ch_1);         /* get voltage at Rh pulled up */
 
 
@@ -307,13 +516,44 @@ void CheckResistor(void)
     ADC_PORT = Probes.Pin_1;                 /* pull up probe-1 directly */
     R_PORT = 0;                              /* set resistor port to low */ 
     R_DDR = Probes.Rl_2;                     /* pull down probe-2 via Rl */
+    #ifdef SW_R_FAST
+    if (Fast)                                /* low R */
+    {
+      U_Ri_H = ReadU(Probes.Ch_1);           /* get voltage at internal R of MCU */
+    }
+    else
+    #endif
     U_Ri_H = ReadU_5ms(Probes.Ch_1);         /* get voltage at internal R of MCU */
     U_Rl_L = ReadU(Probes.Ch_2);             /* get voltage at Rl pulled down */
 
+    #ifdef SW_R_FAST
+    /* U_Rh_L is needed only for measurements with Rh */
+    if ((Fast == 0) || (U_Rl_L < 169))
+    {
+      if (Fast)                         /* estimate was wrong */
+      {
+        /* get precise U_Rh_H again */
+        R_DDR = Probes.Rh_1;            /* enable Rh for probe-1 */
+        R_PORT = Probes.Rh_1;           /* pull up probe-1 via Rh */
+        ADC_DDR = Probes.Pin_2;         /* pull down probe-2 directly */
+        ADC_PORT = 0;
+        U_Rh_H = ReadU_5ms(Probes.Ch_1);     /* get voltage at Rh pulled up */
+
+        /* set probes: Gnd -- Rh -- probe-2 / probe-1 -- Vcc */
+        ADC_DDR = Probes.Pin_1;         /* set probe-1 to output */
+        ADC_PORT = Probes.Pin_1;        /* pull up probe-1 directly */
+        R_PORT = 0;                     /* set resistor port to low */
+      }
+    #endif
+
     /* set probes: Gnd -- Rh -- probe-2 / probe-1 -- Vcc */
     R_DDR = Probes.Rh_2;                /* pull down probe-2 via Rh */
     U_Rh_L = ReadU_5ms(Probes.Ch_2);    /* get voltage at Rh pulled down */
 
+    #ifdef SW_R_FAST
+    }
+    #endif
+
     /* check voltage breakdown to filter out other components */
     if ((U_Rl_H >= 4400) || (U_Rh_H <= 97))   /* R >= 5.1k or R < 9.3k */
     {
@@ -626,6 +866,10 @@ void CheckResistor(void)
       }
     }
   }
+
+  #ifdef SW_R_FAST
+    #undef R_FAST_SAMPLES
+  #endif
 }
 
 
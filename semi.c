@@ -15,6 +15,25 @@
 /* source management */
 #define SEMI_C
 
+/* gate threshold measurement */
+#define VTH_RUNS              3              /* runs for comparator mode */
+
+/* hFE sweep: mode bitfield */
+#define SWEEP_CE              0b00000001     /* common emitter circuit */
+#define SWEEP_BASE_RL         0b00000010     /* base resistor Rl */
+#define SWEEP_LOAD_RL         0b00000100     /* load resistor Rl */
+
+/* diode curve */
+#define DIODE_V_T             25693          /* thermal voltage at 25C (V) */
+#define LN_10                 2303           /* ln(10) * 1000 */
+#define LN_1E9                20723          /* ln(10^9) * 1000 */
+
+/* thyristor/TRIAC currents: load levels */
+#define SCR_LOAD_HIGH         1              /* anode Rl, cathode Gnd */
+#define SCR_LOAD_MID          2              /* anode Rl, cathode Rl */
+#define SCR_LOAD_LOW          3              /* anode Rh, cathode Gnd */
+#define SCR_V_ON              2000           /* max. on-state voltage (mV) */
+
 
 /*
  *  include header files
@@ -186,12 +205,27 @@ void GetLeakageCurrent(uint8_t Mode)
      */
 
     R_DDR = Probes.Rh_2;                /* pull down probe-2 via Rh */
+
+    #ifdef SW_LEAKAGE_AUTO
+    /*
+     *  integrate voltage at Rh until stable
+     *  - sub-mV resolution, down to about 0.1nA
+     *  - I = U / Rh, in 0.1nA, U in V, Rh in 100 Ohms
+     */
+
+    Value = ReadU_Integrated(Probes.Ch_2);   /* get voltage at Rh */
+    Value *= 100;                       /* scale voltage */
+    U_Rl = 1;                           /* voltage already scaled */
+    R_Shunt = R_HIGH / 100;             /* in 100 Ohms */
+    Scale = -10;                        /* 100p */
+    #else
     U_Rl = ReadU_5ms(Probes.Ch_2);      /* get voltage at Rh */
 
     /* neglect MCU's internal resistance */
     R_Shunt =  R_HIGH;
     Scale = -9;                         /* 1n */
     Value = 1000000;                    /* scale voltage to 1 nV */
+    #endif
   }
 
   /* clean up */
@@ -556,20 +590,40 @@ void VerifyMOSFET(void)
  *
  *  requires:
  *  - Type: n-channel or p-channel
+ *  - C_GS in Semi.C_value/C_scale (0 if unknown)
  */
 
 void GetGateThreshold(uint8_t Type)
 {
   int32_t           Ugs = 0;       /* gate threshold voltage / Vth */
   uint8_t           Drain_Rl;      /* Rl register bits for drain */
+  #ifndef SW_FET_VTH_CMP
   uint8_t           Drain_ADC;     /* ADC port register bits for drain */
-  uint8_t           PullMode;      /* pull-up/down mode */
+  #endif
+  uint8_t           PullMode = PULL_10MS;    /* pull-up/down mode */
   uint8_t           Counter;       /* loop counter */
+  #ifdef SW_FET_VTH_CMP
+  uint8_t           Drain_Ch;      /* ADMUX setting for drain */
+  uint8_t           Edge;          /* input capture edge */
+  uint16_t          U_g;           /* gate voltage */
+  #endif
 
   /*
    *  init variables
    */
 
+  /*
+   *  C_GS is measured already (Semi.C_value). A gate below 100nF is
+   *  discharged via Rl within 1ms (more than 14 tau), so we can use
+   *  short discharge pulses.
+   */
+
+  if ((Semi.C_value > 0) &&
+      (CmpValue(Semi.C_value, Semi.C_scale, 100, -9) < 0))
+  {
+    PullMode = PULL_1MS;
+  }
+
   if (Type & TYPE_N_CHANNEL)       /* n-channel */
   {
     /* we assume: probe-1 = D / probe-2 = S / probe-3 = G */
@@ -577,8 +631,10 @@ void GetGateThreshold(uint8_t Type)
     /* probe-1 is still pulled up via Rl */
 
     Drain_Rl =  Probes.Rl_1;
+    #ifndef SW_FET_VTH_CMP
     Drain_ADC = Probes.Pin_1;
-    PullMode = PULL_10MS | PULL_DOWN;
+    #endif
+    PullMode |= PULL_DOWN;
   }
   else                             /* p-channel */
   {
@@ -587,10 +643,120 @@ void GetGateThreshold(uint8_t Type)
     /* probe-1 is still pulled up directly */
 
     Drain_Rl =  Probes.Rl_2;
+    #ifndef SW_FET_VTH_CMP
     Drain_ADC = Probes.Pin_2;
-    PullMode = PULL_10MS | PULL_UP;
+    #endif
+    PullMode |= PULL_UP;
+  }
+
+
+  #ifdef SW_FET_VTH_CMP
+
+  /*
+   *  Let the analog comparator watch the drain and catch the switching
+   *  point with Timer1's input capture. The FET has switched when the
+   *  drain crosses the bandgap voltage. The gate is set to HiZ right
+   *  after that and keeps its voltage, so we can take our time for a
+   *  precise reading.
+   */
+
+  /* set up analog comparator */
+  ADCSRA = ADC_CLOCK_DIV;               /* disable ADC, but keep clock dividers */
+  ADCSRB = (1 << ACME);                 /* use ADC multiplexer as negative input */
+  if (Type & TYPE_N_CHANNEL)       /* n-channel */
+  {
+    /* drain falls below bandgap: comparator output rises */
+    Drain_Ch = ADC_REF_BANDGAP | Probes.Ch_1;     /* drain is probe-1 */
+    Edge = (1 << ICES1);                /* rising edge */
+  }
+  else                             /* p-channel */
+  {
+    /* drain rises above bandgap: comparator output falls */
+    Drain_Ch = ADC_REF_BANDGAP | Probes.Ch_2;     /* drain is probe-2 */
+    Edge = 0;                           /* falling edge */
+  }
+  ADMUX = Drain_Ch;                     /* drain and bandgap reference */
+  ACSR = (1 << ACBG) | (1 << ACIC);     /* use bandgap as positive input, trigger Timer1 */
+  #ifndef ADC_LARGE_BUFFER_CAP
+    /* buffer cap: 1nF or none at all */
+    wait1ms();                          /* time for voltage stabilization */
+  #else
+    /* buffer cap: 100nF */
+    wait10ms();                         /* time for voltage stabilization */
+  #endif
+
+  /* set up Timer1 */
+  TCCR1A = 0;                      /* normal mode */
+  TIMSK1 = 0;                      /* no interrupts */
+
+  for (Counter = 0; Counter < VTH_RUNS; Counter++)
+  {
+    wdt_reset();                        /* reset watchdog */
+
+    /* discharge gate via Rl for 1 or 10 ms */
+    PullProbe(Probes.Rl_3, PullMode);
+
+    /* start timer: prescaler 64, timeout by overflow */
+    TCCR1B = Edge;                      /* stop timer and set edge */
+    TCNT1 = 0;                          /* reset counter */
+    TIFR1 = (1 << ICF1) | (1 << TOV1);  /* clear flags */
+    TCCR1B = Edge | (1 << CS11) | (1 << CS10);   /* start timer */
+
+    /* pull up/down gate via Rh to slowly charge gate */
+    R_DDR = Drain_Rl | Probes.Rh_3;
+
+    /* wait until FET conducts or timer overflows */
+    while (!(TIFR1 & ((1 << ICF1) | (1 << TOV1))));
+
+    R_DDR = Drain_Rl;                   /* set probe-3 to HiZ mode */
+    TCCR1B = 0;                         /* stop timer */
+
+    if (!(TIFR1 & (1 << ICF1)))         /* timeout */
+    {
+      break;                              /* end loop */
+    }
+
+    /* get voltage of gate */
+    ADCSRA = (1 << ADEN) | (1 << ADIF) | ADC_CLOCK_DIV;    /* enable ADC */
+    ADCSRB = 0;                         /* ADC multiplexer for ADC */
+    Cfg.Ref = ADC_REF_BANDGAP;          /* bandgap is still selected */
+    U_g = ReadU(Probes.Ch_3);           /* read gate voltage */
+
+    /* add gate voltage */
+    if (Type & TYPE_N_CHANNEL)          /* n-channel */
+    {
+      Ugs += U_g;                         /* Ugs = U_g */
+    }
+    else                                /* p-channel */
+    {
+      Ugs -= Cfg.Vcc - U_g;               /* Ugs = - (Vcc - U_g) */
+    }
+
+    /* back to comparator */
+    ADCSRA = ADC_CLOCK_DIV;             /* disable ADC */
+    ADCSRB = (1 << ACME);               /* ADC multiplexer for comparator */
+    ADMUX = Drain_Ch;                   /* drain and bandgap reference */
   }
 
+  /* enable ADC again */
+  ADCSRA = (1 << ADEN) | (1 << ADIF) | ADC_CLOCK_DIV;
+  ADCSRB = 0;                      /* disable ADC multiplexer as negative input */
+  Cfg.Ref = ADC_REF_BANDGAP;       /* bandgap might be selected */
+
+  /* calculate V_th */
+  if (Counter == VTH_RUNS)         /* all runs done */
+  {
+    Ugs /= VTH_RUNS;                    /* average */
+  }
+  else                             /* timeout */
+  {
+    Ugs = 0;                            /* no valid result */
+  }
+
+  /* save data */
+  Semi.U_2 = (int16_t)Ugs;         /* gate threshold voltage (in mV) */
+
+  #else
 
   /*
    *  For low reaction times we use the ADC directly.
@@ -613,7 +779,7 @@ void GetGateThreshold(uint8_t Type)
   {
     wdt_reset();                         /* reset watchdog */
 
-    /* discharge gate via Rl for 10 ms */
+    /* discharge gate via Rl for 1 or 10 ms */
     PullProbe(Probes.Rl_3, PullMode);
 
     /* pull up/down gate via Rh to slowly charge gate */
@@ -659,6 +825,8 @@ void GetGateThreshold(uint8_t Type)
 
   /* update reference source for next ADC run */
   Cfg.Ref = ADC_REF_VCC;         /* we've used Vcc as reference */
+
+  #endif
 }
 
 
@@ -905,6 +1073,503 @@ uint32_t Get_hFE_C(uint8_t Type)
 
 
 
+#ifdef FUNC_PROBE_CURRENT
+
+/*
+ *  current through a probe resistor
+ *
+ *  requires:
+ *  - U_R: voltage across resistor (mV)
+ *  - Rl: 1 for Rl, 0 for Rh
+ *  - Ri: internal resistance of MCU in series with Rl (0.1 Ohms)
+ *
+ *  returns:
+ *  - current in nA
+ */
+
+uint32_t ProbeCurrent(uint16_t U_R, uint8_t Rl, uint16_t Ri)
+{
+  uint32_t          I;             /* current */
+
+  I = (uint32_t)U_R * 100000;
+
+  if (Rl)                          /* Rl */
+  {
+    /* I = U / (Rl + Ri), in 100nA, Ri in 0.1 Ohms */
+    I /= (R_LOW * 10) + Ri;
+    I *= 100;                           /* scale to nA */
+  }
+  else                             /* Rh */
+  {
+    /* I = U / Rh, in nA, Rh in 10 Ohms */
+    I /= (R_HIGH / 10);
+  }
+
+  return I;
+}
+
+#endif
+
+
+
+#ifdef SW_HFE_SWEEP
+
+/*
+ *  measure a single operating point for the hFE sweep
+ *  - sorts the operating point into the sweep table by I_c
+ *
+ *  requires:
+ *  - Type: NPN or PNP
+ *  - Mode: bitfield
+ *    SWEEP_CE       common emitter circuit (common collector otherwise)
+ *    SWEEP_BASE_RL  base resistor Rl (Rh otherwise)
+ *    SWEEP_LOAD_RL  load resistor Rl (Rh otherwise)
+ */
+
+void SweepPoint(uint8_t Type, uint8_t Mode)
+{
+  uint8_t           Load_Rl;       /* Rl register bits for load */
+  uint8_t           Load_Rh;       /* Rh register bits for load */
+  uint8_t           Load_Ch;       /* ADC channel for load */
+  uint8_t           Base_R;        /* register bits for base resistor */
+  uint8_t           Up;            /* flag: load pulled up */
+  uint8_t           n;             /* counter */
+  uint16_t          U_L;           /* voltage at load */
+  uint16_t          U_B;           /* voltage at base */
+  uint16_t          U_R;           /* voltage across resistor */
+  int16_t           U_be;          /* V_BE */
+  uint16_t          Ri;            /* internal resistance of MCU */
+  uint32_t          I_b;           /* base current */
+  uint32_t          I_c;           /* collector current */
+  uint32_t          hFE;           /* hFE */
+
+  /*
+   *  we assume:
+   *  - NPN: probe-1 = C / probe-2 = E / probe-3 = B
+   *  - PNP: probe-1 = E / probe-2 = C / probe-3 = B
+   *  - load is pulled up for NPN/common emitter and PNP/common collector
+   */
+
+  if (Type == TYPE_NPN) Up = Mode & SWEEP_CE;
+  else Up = !(Mode & SWEEP_CE);
+
+  if (Up)                          /* load at probe-1 */
+  {
+    /* set probes: Gnd -- probe-2 / probe-1 -- R -- Vcc */
+    Load_Rl = Probes.Rl_1;
+    Load_Rh = Probes.Rh_1;
+    Load_Ch = Probes.Ch_1;
+    ADC_PORT = 0;                       /* pull down directly */
+    ADC_DDR = Probes.Pin_2;             /* enable Gnd for probe-2 */
+    Ri = NV.RiH;                        /* RiH (0.1 Ohms) */
+  }
+  else                             /* load at probe-2 */
+  {
+    /* set probes: Gnd -- R -- probe-2 / probe-1 -- Vcc */
+    Load_Rl = Probes.Rl_2;
+    Load_Rh = Probes.Rh_2;
+    Load_Ch = Probes.Ch_2;
+    ADC_PORT = Probes.Pin_1;            /* pull up directly */
+    ADC_DDR = Probes.Pin_1;             /* enable Vcc for probe-1 */
+    Ri = NV.RiL;                        /* RiL (0.1 Ohms) */
+  }
+
+  if (!(Mode & SWEEP_LOAD_RL)) Load_Rl = Load_Rh;   /* load resistor Rh */
+
+  if (Mode & SWEEP_BASE_RL) Base_R = Probes.Rl_3;   /* base resistor Rl */
+  else Base_R = Probes.Rh_3;                        /* base resistor Rh */
+
+  /* pull load and base resistors */
+  R_PORT = 0;
+  if (Up) R_PORT = Load_Rl;             /* pull up load */
+  if (Type == TYPE_NPN) R_PORT |= Base_R;    /* pull up base */
+  R_DDR = Load_Rl | Base_R;             /* enable resistors */
+
+  U_L = ReadU_5ms(Load_Ch);             /* voltage at load */
+  U_B = ReadU(Probes.Ch_3);             /* voltage at base */
+
+
+  /*
+   *  calculate I_b, I_c and V_BE
+   *  - CE: U_e is Gnd (NPN) or Vcc (PNP)
+   *  - CC: U_e is U_L
+   */
+
+  /* I_c or I_e */
+  U_R = U_L;                            /* U_R = U_L */
+  if (Up) U_R = Cfg.Vcc - U_L;          /* U_R = Vcc - U_L */
+  I_c = ProbeCurrent(U_R, Mode & SWEEP_LOAD_RL, Ri);
+
+  /* I_b and V_BE */
+  if (Type == TYPE_NPN)            /* NPN */
+  {
+    U_R = Cfg.Vcc - U_B;                /* U_R_b = Vcc - U_b */
+    U_be = U_B;                         /* CE: U_b - 0 */
+    if (!(Mode & SWEEP_CE)) U_be -= U_L;     /* CC: U_b - U_e */
+    Ri = NV.RiH;                        /* base pulled up */
+  }
+  else                             /* PNP */
+  {
+    U_R = U_B;                          /* U_R_b = U_b */
+    U_be = Cfg.Vcc - U_B;               /* CE: Vcc - U_b */
+    if (!(Mode & SWEEP_CE)) U_be = U_L - U_B;     /* CC: U_e - U_b */
+    Ri = NV.RiL;                        /* base pulled down */
+  }
+  if (U_be < 0) U_be = 0;               /* sanitize */
+
+  I_b = ProbeCurrent(U_R, Mode & SWEEP_BASE_RL, Ri);
+
+  /* CC: I_c = I_e - I_b */
+  if (!(Mode & SWEEP_CE))
+  {
+    if (I_c > I_b) I_c -= I_b;
+    else I_c = 0;
+  }
+
+  /* hFE = I_c / I_b */
+  if (I_b == 0) I_b = 1;                /* prevent division by zero */
+  hFE = I_c / I_b;
+  if (hFE > UINT16_MAX) hFE = UINT16_MAX;
+
+
+  /*
+   *  insert into table (sorted by I_c)
+   */
+
+  n = HFE_Points;
+  while ((n > 0) && (HFE_Sweep[n - 1].I_c > I_c))
+  {
+    HFE_Sweep[n] = HFE_Sweep[n - 1];    /* move up */
+    n--;
+  }
+
+  HFE_Sweep[n].I_b = I_b;
+  HFE_Sweep[n].I_c = I_c;
+  HFE_Sweep[n].U_be = (uint16_t)U_be;
+  HFE_Sweep[n].hFE = (uint16_t)hFE;
+  HFE_Points++;
+}
+
+
+
+/*
+ *  hFE sweep of a detected BJT
+ *  - steps base drive through the available test circuits and
+ *    resistor combinations (low to high I_c):
+ *    CC with Rb = Rh and Re = Rh (about 10A)
+ *    CE with Rb = Rh and Rc = Rl
+ *    CC with Rb = Rh and Re = Rl
+ *    CC with Rb = Rl and Re = Rl (about 6mA)
+ *  - results are stored in HFE_Sweep[] (sorted by I_c)
+ *
+ *  returns:
+ *  - number of operating points
+ */
+
+uint8_t BJT_Sweep(void)
+{
+  uint8_t           Type;          /* NPN or PNP */
+
+  HFE_Points = 0;                  /* reset table */
+
+  if (Check.Found != COMP_BJT) return 0;     /* no BJT */
+
+  /* set probes based on BJT type */
+  if (Check.Type & TYPE_NPN)       /* NPN */
+  {
+    /* probe-1 = C / probe-2 = E / probe-3 = B */
+    Type = TYPE_NPN;
+    UpdateProbes(Semi.B, Semi.C, Semi.A);
+  }
+  else                             /* PNP */
+  {
+    /* probe-1 = E / probe-2 = C / probe-3 = B */
+    Type = TYPE_PNP;
+    UpdateProbes(Semi.C, Semi.B, Semi.A);
+  }
+
+  /* operating points */
+  SweepPoint(Type, 0);
+  SweepPoint(Type, SWEEP_CE | SWEEP_LOAD_RL);
+  SweepPoint(Type, SWEEP_LOAD_RL);
+  SweepPoint(Type, SWEEP_BASE_RL | SWEEP_LOAD_RL);
+
+  /* reset probes */
+  R_DDR = 0;                       /* set resistor port to HiZ mode */
+  R_PORT = 0;
+  ADC_DDR = 0;                     /* set ADC port to HiZ mode */
+  ADC_PORT = 0;
+
+  return HFE_Points;
+}
+
+#endif
+
+
+
+#ifdef SW_DIODE_CURVE
+
+/*
+ *  natural logarithm
+ *  - fixed point math via binary logarithm with 10 fractional bits
+ *
+ *  requires:
+ *  - Value: > 0
+ *
+ *  returns:
+ *  - ln(Value) in 0.001
+ */
+
+uint16_t NaturalLog(uint32_t Value)
+{
+  uint32_t          Log = 14 << 10;     /* log2 (Q10), normalized to 2^14 */
+  uint16_t          Bit = 512;          /* fractional bit */
+
+  if (Value == 0) return 0;             /* prevent endless loop */
+
+  /* normalize value to 1.0-1.99 (Q14): integer part of log2 */
+  while (Value >= 0x8000)               /* scale down */
+  {
+    Value >>= 1;
+    Log += 1024;
+  }
+  while (Value < 0x4000)                /* scale up */
+  {
+    Value <<= 1;
+    Log -= 1024;
+  }
+
+  /* fractional part of log2: square value and check for >= 2 */
+  while (Bit > 0)
+  {
+    Value *= Value;                     /* square (Q28) */
+    Value >>= 14;                       /* scale back to Q14 */
+    if (Value >= 0x8000)                /* >= 2 */
+    {
+      Value >>= 1;                      /* divide by 2 */
+      Log |= Bit;                       /* set bit */
+    }
+    Bit >>= 1;                          /* next bit */
+  }
+
+  /* ln(x) = log2(x) * ln(2) */
+  Log *= 693;                           /* ln(2) * 1000 */
+  Log /= 1024;                          /* remove Q10 scaling */
+
+  return (uint16_t)Log;
+}
+
+
+
+/*
+ *  measure a single point of the diode's I/V curve
+ *  - anode is pulled up via resistor
+ *  - cathode is pulled down directly or via resistor
+ *  - appends point to DiodeCurve[]
+ *
+ *  requires:
+ *  - Up_R: register bits for anode resistor (Rl_1 or Rh_1)
+ *  - Down_R: register bits for cathode resistor (0 for Gnd)
+ */
+
+void CurvePoint(uint8_t Up_R, uint8_t Down_R)
+{
+  uint16_t          U_A;           /* voltage at anode */
+  uint16_t          U_C;           /* voltage at cathode */
+  uint32_t          I_f;           /* forward current */
+
+  /* we assume: probe-1 = A / probe-2 = C */
+  /* set probes: Gnd -- (R --) probe-2 / probe-1 -- R -- Vcc */
+  ADC_PORT = 0;
+  if (Down_R) ADC_DDR = 0;              /* cathode via resistor */
+  else ADC_DDR = Probes.Pin_2;          /* pull down cathode directly */
+  R_PORT = Up_R;                        /* pull up anode via resistor */
+  R_DDR = Up_R | Down_R;                /* enable resistors */
+
+  U_A = ReadU_5ms(Probes.Ch_1);         /* get voltage at anode */
+  U_C = ReadU(Probes.Ch_2);             /* get voltage at cathode */
+
+  /* I_f based on voltage across anode resistor */
+  if (U_A < Cfg.Vcc) I_f = Cfg.Vcc - U_A;
+  else I_f = 0;
+  I_f = ProbeCurrent((uint16_t)I_f, Up_R == Probes.Rl_1, NV.RiH);
+
+  /* V_f = U_Anode - U_Cathode */
+  if (U_A > U_C) U_A -= U_C;
+  else U_A = 0;
+
+  DiodeCurve[CurvePoints].I_f = I_f;
+  DiodeCurve[CurvePoints].V_f = U_A;
+  CurvePoints++;
+}
+
+
+
+/*
+ *  I/V curve of a diode and Shockley fit
+ *  - steps forward current through the resistor combinations:
+ *    Rh to Rh (about 5A), Rh to Gnd (about 10A),
+ *    Rl to Rl (about 3mA), Rl to Gnd (about 6mA)
+ *  - fits Shockley model I = Is (exp(V_d / (n V_T)) - 1), V = V_d + I Rs
+ *    n  from lowest and third point (Rs corrected)
+ *    Rs from deviation of the two highest points
+ *    Is from lowest point
+ *  - classifies diode by V_f at about 3mA
+ *  - results are stored in DiodeCurve[] and DiodeFit
+ *
+ *  requires:
+ *  - Diode: pointer to diode
+ *
+ *  returns:
+ *  - 1 on success
+ *  - 0 on any problem
+ */
+
+uint8_t Diode_Curve(Diode_Type *Diode)
+{
+  uint8_t           Flag = 0;      /* return value */
+  uint8_t           n;             /* counter */
+  Curve_Type        *P1;           /* lowest point */
+  Curve_Type        *P3;           /* third point */
+  Curve_Type        *P4;           /* highest point */
+  uint16_t          Ln_13;         /* ln(I3 / I1) in 0.001 */
+  uint16_t          Ln_34;         /* ln(I4 / I3) in 0.001 */
+  uint16_t          R_s = 0;       /* series resistance (0.01 Ohms) */
+  int32_t           U_Diff;        /* voltage difference (V) */
+  uint32_t          nV_T = 0;      /* n * V_T (V) */
+  uint32_t          Value;         /* temporary value */
+  int8_t            Exp = 0;       /* exponent of Is */
+
+  CurvePoints = 0;                 /* reset table */
+
+  DischargeProbes();               /* try to discharge probes */
+  if (Check.Found == COMP_ERROR) return Flag;     /* skip on error */
+
+  /* probe-1 = A / probe-2 = C */
+  UpdateProbes2(Diode->A, Diode->C);
+
+  /* curve points (low to high current) */
+  CurvePoint(Probes.Rh_1, Probes.Rh_2);
+  CurvePoint(Probes.Rh_1, 0);
+  CurvePoint(Probes.Rl_1, Probes.Rl_2);
+  CurvePoint(Probes.Rl_1, 0);
+
+  /* reset probes */
+  R_DDR = 0;                       /* set resistor port to HiZ mode */
+  R_PORT = 0;
+  ADC_DDR = 0;                     /* set ADC port to HiZ mode */
+  ADC_PORT = 0;
+
+  P1 = &DiodeCurve[0];
+  P3 = &DiodeCurve[2];
+  P4 = &DiodeCurve[3];
+
+  /* current and voltage have to rise */
+  if ((P1->I_f == 0) || (P3->I_f <= P1->I_f) || (P4->I_f <= P3->I_f) ||
+      (P3->V_f <= P1->V_f) || (P4->V_f < P3->V_f))
+  {
+    return Flag;
+  }
+
+  Ln_13 = NaturalLog(P3->I_f) - NaturalLog(P1->I_f);
+  Ln_34 = NaturalLog(P4->I_f) - NaturalLog(P3->I_f);
+  if ((Ln_13 < 10) || (Ln_34 < 10)) return Flag;     /* not enough spread */
+
+
+  /*
+   *  n and Rs
+   *  - V3 - V1 - I3 Rs = n V_T ln(I3 / I1)
+   *  - V4 - V3 - n V_T ln(I4 / I3) = Rs (I4 - I3)
+   *  - two runs: first run assumes Rs = 0
+   */
+
+  n = 2;
+  while (n > 0)
+  {
+    /* n V_T */
+    U_Diff = (int32_t)(P3->V_f - P1->V_f) * 1000;     /* in V */
+    Value = (uint32_t)R_s * (P3->I_f / 1000);         /* 0.01 Ohms * A */
+    U_Diff -= (int32_t)(Value / 100);                 /* - I3 Rs */
+    if (U_Diff <= 0) return Flag;                     /* Rs too large */
+    nV_T = (uint32_t)U_Diff * 100;
+    nV_T /= (Ln_13 + 5) / 10;
+    if (nV_T > (DIODE_V_T * 10)) return Flag;         /* n > 10 */
+
+    /* Rs */
+    U_Diff = (int32_t)(P4->V_f - P3->V_f) * 1000;     /* in V */
+    Value = nV_T * Ln_34 / 1000;                      /* n V_T ln(I4 / I3) */
+    U_Diff -= (int32_t)Value;
+    if (U_Diff < 0) U_Diff = 0;                       /* no Rs */
+    Value = (P4->I_f - P3->I_f) / 1000;               /* delta I in A */
+    if (Value == 0) return Flag;                      /* prevent division by zero */
+    Value = (uint32_t)U_Diff * 100 / Value;           /* in 0.01 Ohms */
+    if (Value > UINT16_MAX) Value = UINT16_MAX;
+    R_s = (uint16_t)Value;
+
+    n--;                           /* next run */
+  }
+
+  DiodeFit.n = (uint16_t)(nV_T * 100 / DIODE_V_T);   /* in 0.01 */
+  DiodeFit.R_s = R_s;
+
+
+  /*
+   *  Is
+   *  - ln(Is) = ln(I1) - V1 / (n V_T)
+   *  - convert into mantissa (1.0-9.9) and decimal exponent
+   */
+
+  U_Diff = NaturalLog(P1->I_f);         /* ln(I1 in nA) */
+  U_Diff -= LN_1E9;                     /* ln(I1 in A) */
+  Value = (uint32_t)P1->V_f * 100000;   /* V1 in 0.01V */
+  Value /= nV_T / 10;                   /* V1 / (n V_T) in 0.001 */
+  U_Diff -= (int32_t)Value;             /* ln(Is in A) */
+
+  while (U_Diff < 0)                    /* scale up to 10^0 */
+  {
+    U_Diff += LN_10;
+    Exp--;
+  }
+  while (U_Diff >= LN_10)               /* scale down to 10^0 */
+  {
+    U_Diff -= LN_10;
+    Exp++;
+  }
+
+  /* find mantissa by ln(m / 10) <= remainder */
+  Value = NaturalLog(10);               /* ln(10) as base */
+  n = 10;
+  while ((n < 99) && ((NaturalLog(n + 1) - Value) <= (uint32_t)U_Diff))
+  {
+    n++;
+  }
+
+  DiodeFit.I_s = n;
+  DiodeFit.I_s_Exp = Exp;
+
+
+  /*
+   *  diode class based on V_f at about 3mA
+   */
+
+  Value = P3->V_f;
+  if (Value < 450) n = DIODE_SCHOTTKY;       /* Schottky/Ge */
+  else if (Value < 1000) n = DIODE_SILICON;  /* Si */
+  else if (Value < 1650) n = DIODE_LED_IR;   /* IR LED */
+  else if (Value < 2050) n = DIODE_LED_RED;  /* red LED */
+  else if (Value < 2550) n = DIODE_LED_YG;   /* yellow/green LED */
+  else n = DIODE_LED_BW;                     /* blue/white LED */
+  DiodeFit.Class = n;
+
+  Flag = 1;                        /* signal success */
+
+  return Flag;
+}
+
+#endif
+
+
+
 /*
  *  check for BJT, enhancement-mode MOSFET and IGBT
  *  - sets hFE test circuit type in Semi.Flags
@@ -1281,8 +1946,6 @@ void CheckTransistor(uint8_t BJT_Type, uint16_t U_Rl)
       #endif
     }
 
-    GetGateThreshold(FET_Type);    /* measure gate threshold voltage */
-
     Check.Done |= DONE_SEMI;       /* transistor detected */
 
     /* save data */
@@ -1299,11 +1962,36 @@ void CheckTransistor(uint8_t BJT_Type, uint16_t U_Rl)
       Semi.C = Probes.ID_1;        /* probe ID for source */
     }
 
-    /* Gate-Source capacitance */
+    /*
+     *  Gate-Source capacitance
+     *  - measured before V_th, which takes C_GS into account for
+     *    the gate discharge time
+     */
+
     MeasureCap(Semi.A, Semi.C, 0);      /* measure capacitance */
     Semi.C_value = Caps[0].Value;       /* save value */
     Semi.C_scale = Caps[0].Scale;
     RestoreProbes();                    /* restore original probe IDs */
+
+    /* set probes back for drain current */
+    if (FET_Type == TYPE_N_CHANNEL)     /* n-channel */
+    {
+      /* set probes: Gnd -- probe-2 / probe-1 -- Rl -- Vcc / probe-3 -- Rh -- Vcc */
+      ADC_PORT = 0;
+      ADC_DDR = Probes.Pin_2;           /* pull down source directly */
+      R_PORT = Probes.Rl_1 | Probes.Rh_3;    /* pull up drain via Rl and gate via Rh */
+      R_DDR = Probes.Rl_1 | Probes.Rh_3;     /* enable resistors */
+    }
+    else                                /* p-channel */
+    {
+      /* set probes: Gnd -- Rl -- probe-2 / probe-1 -- Vcc / probe-3 -- Rh -- Gnd */
+      ADC_PORT = Probes.Pin_1;          /* pull up source directly */
+      ADC_DDR = Probes.Pin_1;
+      R_PORT = 0;                       /* pull down drain via Rl and gate via Rh */
+      R_DDR = Probes.Rl_2 | Probes.Rh_3;     /* enable resistors */
+    }
+
+    GetGateThreshold(FET_Type);    /* measure gate threshold voltage */
   }
 }
 
@@ -2029,6 +2717,187 @@ uint8_t CheckThyristorTriac(void)
 
 
 
+#ifdef SW_SCR_CURRENTS
+
+/*
+ *  stop load current of thyristor/TRIAC
+ *  - discharges gate too
+ */
+
+void SCR_Off(void)
+{
+  R_DDR = 0;                            /* disable all probe resistors */
+  R_PORT = 0;
+  ADC_DDR = 0;                          /* set all probes to HiZ */
+  ADC_PORT = 0;
+  PullProbe(Probes.Rl_3, PULL_10MS | PULL_DOWN);    /* discharge gate */
+}
+
+
+
+/*
+ *  set load of thyristor/TRIAC and check for conduction
+ *  - adds new current paths before removing the old ones, so a
+ *    conducting DUT sees no interruption of the load current
+ *
+ *  requires:
+ *  - Level: load level
+ *    SCR_LOAD_HIGH  anode Rl, cathode Gnd (about 6mA)
+ *    SCR_LOAD_MID   anode Rl, cathode Rl (about 3mA)
+ *    SCR_LOAD_LOW   anode Rh, cathode Gnd (about 10A)
+ *
+ *  returns:
+ *  - anode current in nA if DUT conducts
+ *  - 0 if DUT doesn't conduct
+ */
+
+uint32_t SCR_Load(uint8_t Level)
+{
+  uint8_t           Up_R;          /* anode resistor */
+  uint8_t           Down_R = 0;    /* cathode resistor */
+  uint16_t          U_A;           /* voltage at anode */
+  uint16_t          U_C;           /* voltage at cathode */
+  uint32_t          I_A = 0;       /* anode current */
+
+  /* we assume: probe-1 = A / probe-2 = C / probe-3 = G */
+  if (Level == SCR_LOAD_LOW) Up_R = Probes.Rh_1;
+  else Up_R = Probes.Rl_1;
+  if (Level == SCR_LOAD_MID) Down_R = Probes.Rl_2;
+
+  /* add new paths */
+  ADC_PORT = 0;
+  R_PORT |= Up_R;                       /* pull up anode */
+  R_DDR |= Up_R | Down_R;               /* enable resistors */
+  if (Down_R == 0) ADC_DDR = Probes.Pin_2;     /* pull down cathode directly */
+
+  /* remove old paths */
+  if (Down_R) ADC_DDR = 0;              /* cathode via Rl only */
+  R_DDR = Up_R | Down_R;                /* disable other resistors */
+  R_PORT = Up_R;
+
+  U_A = ReadU_5ms(Probes.Ch_1);         /* get voltage at anode */
+  U_C = ReadU(Probes.Ch_2);             /* get voltage at cathode */
+
+  if (U_A < U_C + SCR_V_ON)        /* DUT conducts */
+  {
+    /* current based on voltage across anode resistor */
+    I_A = ProbeCurrent(Cfg.Vcc - U_A, Level != SCR_LOAD_LOW, NV.RiH);
+  }
+
+  return I_A;
+}
+
+
+
+/*
+ *  trigger thyristor/TRIAC by pulling gate up via resistor
+ *  - discharges gate afterwards
+ *
+ *  requires:
+ *  - Gate_R: register bits for gate resistor (Rl_3 or Rh_3)
+ *
+ *  returns:
+ *  - gate current in nA
+ */
+
+uint32_t SCR_Gate(uint8_t Gate_R)
+{
+  uint16_t          U_G;           /* voltage at gate */
+
+  R_PORT |= Gate_R;                     /* pull up gate */
+  R_DDR |= Gate_R;                      /* enable resistor */
+  U_G = ReadU_5ms(Probes.Ch_3);         /* get voltage at gate */
+  R_DDR &= ~Gate_R;                     /* set gate to HiZ */
+  R_PORT &= ~Gate_R;
+  PullProbe(Probes.Rl_3, PULL_10MS | PULL_DOWN);    /* discharge gate */
+
+  /* current based on voltage across gate resistor */
+  if (U_G > Cfg.Vcc) U_G = Cfg.Vcc;
+  return ProbeCurrent(Cfg.Vcc - U_G, Gate_R == Probes.Rl_3, NV.RiH);
+}
+
+
+
+/*
+ *  gate trigger, latching and holding current of thyristor/TRIAC
+ *  - The tester provides only a few discrete current levels. So the
+ *    results are the lowest tested currents which still trigger, latch
+ *    or hold the DUT, i.e. upper limits of the DUT's real values.
+ *  - trigger: gate driven via Rh (about 10A), then via Rl (about 6mA)
+ *  - latching: trigger DUT at decreasing load levels and check if it
+ *    keeps conducting after the gate is discharged
+ *  - holding: latch DUT at the highest load level and step the load
+ *    down without interruption until the DUT turns off
+ *  - TRIAC is checked in Q1 (MT2 and gate positive)
+ *  - results are stored in SCR (0 if not found)
+ */
+
+void SCR_Currents(void)
+{
+  uint8_t           Gate_R;        /* gate resistor */
+  uint8_t           Level;         /* load level */
+  uint32_t          I_G;           /* gate current */
+  uint32_t          I_A;           /* anode current */
+
+  SCR.I_GT = 0;
+  SCR.I_L = 0;
+  SCR.I_H = 0;
+
+  /* set probes: probe-1 = A/MT2, probe-2 = C/MT1, probe-3 = G */
+  UpdateProbes(Semi.B, Semi.C, Semi.A);
+
+  /* trigger current: try Rh first */
+  Gate_R = Probes.Rh_3;
+  while (1)
+  {
+    SCR_Off();                          /* reset DUT */
+    SCR_Load(SCR_LOAD_HIGH);            /* set load */
+    I_G = SCR_Gate(Gate_R);             /* trigger */
+
+    if (SCR_Load(SCR_LOAD_HIGH))        /* DUT conducts */
+    {
+      SCR.I_GT = I_G;                   /* save gate current */
+      break;
+    }
+
+    if (Gate_R == Probes.Rl_3)          /* no more gate drive */
+    {
+      SCR_Off();                        /* stop load current */
+      return;
+    }
+
+    Gate_R = Probes.Rl_3;               /* try Rl */
+  }
+
+  /* latching current: trigger at decreasing load levels */
+  for (Level = SCR_LOAD_HIGH; Level <= SCR_LOAD_LOW; Level++)
+  {
+    SCR_Off();                          /* reset DUT */
+    SCR_Load(Level);                    /* set load */
+    SCR_Gate(Gate_R);                   /* trigger */
+    I_A = SCR_Load(Level);              /* check conduction */
+    if (I_A == 0) break;                /* not latched */
+    SCR.I_L = I_A;                      /* save anode current */
+  }
+
+  /* holding current: latch at highest level and step load down */
+  SCR_Off();                            /* reset DUT */
+  SCR_Load(SCR_LOAD_HIGH);              /* set load */
+  SCR_Gate(Gate_R);                     /* trigger */
+  for (Level = SCR_LOAD_HIGH; Level <= SCR_LOAD_LOW; Level++)
+  {
+    I_A = SCR_Load(Level);              /* lower load and check conduction */
+    if (I_A == 0) break;                /* turned off */
+    SCR.I_H = I_A;                      /* save anode current */
+  }
+
+  SCR_Off();                            /* stop load current */
+}
+
+#endif
+
+
+
 /*
  *  check for PUT (Programmable Unijunction Transistor)
  */
@@ -2236,6 +3105,19 @@ void CheckUJT(void)
  * ************************************************************************ */
 
 
+/* local constants */
+#undef VTH_RUNS
+#undef SWEEP_CE
+#undef SWEEP_BASE_RL
+#undef SWEEP_LOAD_RL
+#undef DIODE_V_T
+#undef LN_10
+#undef LN_1E9
+#undef SCR_LOAD_HIGH
+#undef SCR_LOAD_MID
+#undef SCR_LOAD_LOW
+#undef SCR_V_ON
+
 /* source management */
 #undef SEMI_C
 
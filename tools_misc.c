@@ -125,6 +125,125 @@ void ProbePinout(uint8_t Mode)
  * ************************************************************************ */
 
 
+#ifdef ZENER_SYNC
+
+/* local constants for sampling */
+#define ZENER_SAMPLES         32        /* samples per burst */
+#define ZENER_BURST_TIME      20000     /* duration of burst (s) */
+
+
+/*
+ *  sample voltage of Zener check
+ *  - bursts of ZENER_SAMPLES samples gated by Timer1, each burst spans
+ *    20ms (also suppresses 50/60Hz hum)
+ *  - the boost converter runs free, so the samples can't be locked to
+ *    its switching, but fall on varying phases of the ripple
+ *  - bandgap reference for low voltages
+ *  - voltages are scaled like ReadU() based results:
+ *    10:1 voltage divider: 10mV
+ *    custom voltage divider: 1mV
+ *
+ *  requires:
+ *  - Bursts: number of bursts
+ *  - Zener: pointer to sampled voltages
+ */
+
+void Zener_Sample(uint8_t Bursts, Zener_Type *Zener)
+{
+  uint8_t           Ref = ADC_REF_BANDGAP;   /* voltage reference */
+  uint8_t           n;             /* counter */
+  uint16_t          Sample;        /* ADC reading */
+  uint16_t          Min = UINT16_MAX;   /* min. ADC reading */
+  uint16_t          Max = 0;       /* max. ADC reading */
+  uint16_t          Count = 0;     /* number of samples */
+  uint32_t          Sum = 0;       /* sum of ADC readings */
+  uint32_t          Value;         /* value */
+
+  /* sampling interval in timer ticks (64 MCU cycles) */
+  #define ZENER_TICKS   ((ZENER_BURST_TIME / ZENER_SAMPLES) * MCU_CYCLES_PER_US / 64)
+
+  /* Vcc reference for higher voltages */
+  if (ReadU(TP_ZENER) > 1000) Ref = ADC_REF_VCC;
+
+  ADC_CaptureStart(TP_ZENER, Ref, ZENER_TICKS);
+
+  while (Bursts > 0)               /* burst loop */
+  {
+    n = ZENER_SAMPLES;
+    while (n > 0)                  /* sample loop */
+    {
+      Sample = ADC_CaptureSample();     /* get ADC reading */
+      Sum += Sample;
+      if (Sample < Min) Min = Sample;   /* update minimum */
+      if (Sample > Max) Max = Sample;   /* update maximum */
+      n--;
+    }
+
+    wdt_reset();                   /* reset watchdog */
+    Count += ZENER_SAMPLES;
+    Bursts--;                      /* next burst */
+  }
+
+  ADC_CaptureStop();
+
+  /* mean voltage: U = Sum * U_ref / 1024 / samples */
+  if (Ref == ADC_REF_BANDGAP) Value = Cfg.Bandgap;
+  else Value = Cfg.Vcc;
+  Value *= Sum;
+  Value /= 1024;
+  Value /= Count;
+  Zener->Mean = (uint16_t)Value;
+
+  /* min/max voltage */
+  Zener->Min = ADC_CaptureU(Min, Ref);
+  Zener->Max = ADC_CaptureU(Max, Ref);
+
+  #ifdef ZENER_DIVIDER_CUSTOM
+  /*
+   *  ADC pin is connected to a voltage divider (top: R1 / bottom: R2).
+   *  - Uin = (U2 * (R1 + R2)) / R2
+   */
+
+  Value = (((uint32_t)(ZENER_R1 + ZENER_R2) * 1000) / ZENER_R2);  /* factor (0.001) */
+  Zener->Mean = (uint16_t)((Value * Zener->Mean) / 1000);
+  Zener->Min = (uint16_t)((Value * Zener->Min) / 1000);
+  Zener->Max = (uint16_t)((Value * Zener->Max) / 1000);
+  #endif
+
+  #undef ZENER_TICKS
+}
+
+
+
+/*
+ *  display ripple of Zener check
+ *  - format: (<ripple>)
+ *
+ *  requires:
+ *  - Ripple: peak-to-peak voltage (scale like Zener_Sample())
+ */
+
+void Show_ZenerRipple(uint16_t Ripple)
+{
+  Display_Space();
+  Display_Char('(');
+  #ifndef ZENER_DIVIDER_CUSTOM
+    Display_Value(Ripple, -2, 'V');     /* in 10mV */
+  #else
+    Display_Value(Ripple, -3, 'V');     /* in mV */
+  #endif
+  Display_Char(')');
+}
+
+
+/* clean up local constants for sampling */
+#undef ZENER_SAMPLES
+#undef ZENER_BURST_TIME
+
+#endif
+
+
+
 #if defined (HW_ZENER) && ! defined (ZENER_UNSWITCHED)
 
 /*
@@ -143,7 +262,13 @@ void Zener_Tool(void)
   uint8_t                Counter2 = 0;       /* time between two key presses */
   uint16_t               U1;                 /* current voltage */
   uint16_t               Min = UINT16_MAX;   /* minimal voltage */
-  #ifdef ZENER_DIVIDER_CUSTOM
+  #ifdef ZENER_SYNC
+  Zener_Type             Zener;              /* sampled voltages */
+  uint16_t               Mean = 0;           /* moving average */
+  uint16_t               Low = UINT16_MAX;   /* lowest voltage */
+  uint16_t               High = 0;           /* highest voltage */
+  #endif
+  #if defined (ZENER_DIVIDER_CUSTOM) && ! defined (ZENER_SYNC)
   uint32_t               Value;              /* value */
   #endif
 
@@ -205,6 +330,11 @@ void Zener_Tool(void)
         #endif
       #endif
 
+      #ifdef ZENER_SYNC
+      /* get voltage: single burst (20ms) */
+      Zener_Sample(1, &Zener);
+      U1 = Zener.Mean;             /* mean voltage */
+      #else
       /* get voltage (10:1 voltage divider) */
       U1 = ReadU(TP_ZENER);        /* read voltage (in mV) */
 
@@ -225,6 +355,7 @@ void Zener_Tool(void)
       Value /= 1000;                   /* scale to mV */
       U1 = (uint16_t)Value;            /* keep 2 bytes */
       #endif
+      #endif
 
       /* display voltage */
       if (Counter % 8 == 0)        /* every 8 loop runs (240ms) */
@@ -235,20 +366,40 @@ void Zener_Tool(void)
         #else
           Display_Value(U1, -3, 'V');   /* display current voltage (1mV) */
         #endif
+        #ifdef ZENER_SYNC
+        Show_ZenerRipple(Zener.Max - Zener.Min);    /* display ripple */
+        #endif
       }
 
       /* data hold */
       if (Counter == 0)            /* first loop run */
       {
         Min = UINT16_MAX;          /* reset minimum to default */
+        #ifdef ZENER_SYNC
+        Mean = 0;                  /* reset tracker */
+        Low = UINT16_MAX;
+        High = 0;
+        #endif
       }
       else if (Counter >= 10)      /* ensure stable voltage */
       {
         if (U1 < Min) Min = U1;    /* update minimum */
+
+        #ifdef ZENER_SYNC
+        /* moving average (1/8) and min/max tracker */
+        if (Mean == 0) Mean = U1;  /* first value */
+        else Mean = (uint16_t)((((uint32_t)Mean * 7) + U1) / 8);
+        if (Zener.Min < Low) Low = Zener.Min;
+        if (Zener.Max > High) High = Zener.Max;
+        #endif
       }
 
       /* timing */
+      #ifdef ZENER_SYNC
+      MilliSleep(10);              /* delay next run (burst takes 20ms) */
+      #else
       MilliSleep(30);              /* delay next run / also debounce by 30ms */
+      #endif
       Counter++;                   /* increase key press time counter */
       if (Counter > 100)           /* prevent overflow & timer (about 3s) */
       {
@@ -302,6 +453,15 @@ void Zener_Tool(void)
 
       if (Min != UINT16_MAX)       /* got updated value */
       {
+        #ifdef ZENER_SYNC
+        /* display moving average and ripple */
+        #ifndef ZENER_DIVIDER_CUSTOM
+          Display_Value(Mean, -2, 'V');    /* display mean voltage */
+        #else
+          Display_Value(Mean, -3, 'V');    /* display mean voltage */
+        #endif
+        Show_ZenerRipple(High - Low);      /* display ripple */
+        #else
         #ifndef ZENER_DIVIDER_CUSTOM
           Display_Value(Min, -2, 'V');     /* display minimal voltage */
         #else
@@ -309,6 +469,7 @@ void Zener_Tool(void)
         #endif
         Display_Space();
         Display_EEString(Min_str);         /* display: Min */
+        #endif
       }
       else                         /* unchanged default */
       {
@@ -341,7 +502,10 @@ void Zener_Tool(void)
   uint8_t                Run = 1;       /* control flag */
   uint8_t                Test;          /* user feedback */
   uint16_t               U1;            /* voltage */
-  #ifdef ZENER_DIVIDER_CUSTOM
+  #ifdef ZENER_SYNC
+  Zener_Type             Zener;         /* sampled voltages */
+  #endif
+  #if defined (ZENER_DIVIDER_CUSTOM) && ! defined (ZENER_SYNC)
   uint32_t               Value;         /* value */
   #endif
 
@@ -366,6 +530,11 @@ void Zener_Tool(void)
 
   while (Run)
   {
+    #ifdef ZENER_SYNC
+    /* get voltage: 8 bursts (160ms) */
+    Zener_Sample(8, &Zener);
+    U1 = Zener.Mean;               /* mean voltage */
+    #else
     /* get voltage */
     U1 = ReadU(TP_ZENER);          /* read voltage (in mV) */
 
@@ -386,6 +555,7 @@ void Zener_Tool(void)
     Value /= 1000;                   /* scale to mV */
     U1 = (uint16_t)Value;            /* keep 2 bytes */
     #endif
+    #endif
 
     /* display voltage */
     LCD_ClearLine2();              /* clear line #2 */
@@ -394,6 +564,9 @@ void Zener_Tool(void)
     #else
       Display_Value(U1, -3, 'V');  /* display current voltage */
     #endif
+    #ifdef ZENER_SYNC
+    Show_ZenerRipple(Zener.Max - Zener.Min);     /* display ripple */
+    #endif
 
     /* user feedback (1s delay) */
     Test = TestKey(1000, CHECK_KEY_TWICE | CHECK_BAT | CURSOR_STEADY);
@@ -528,6 +701,7 @@ void ESR_Tool(void)
   {
     /*
      *  short or long key press -> measure
+     *  (long key press: precise ESR with 5 times the gate time)
      *  two short key presses -> exit tool
      */
 
@@ -561,7 +735,16 @@ void ESR_Tool(void)
 
         /* show ESR */
         Display_Space();
+        #ifdef SW_ESR_GATETIME
+        if (Test == KEY_LONG)           /* long key press */
+        {
+          Cfg.ESR_Gate = ESR_GATE * 5;  /* precise measurement */
+        }
+        #endif
         ESR = MeasureESR(Cap);
+        #ifdef SW_ESR_GATETIME
+        Cfg.ESR_Gate = ESR_GATE;        /* back to default */
+        #endif
         if (ESR < UINT16_MAX)           /* got valid ESR */
         {
           Display_Value(ESR, -2, LCD_CHAR_OMEGA);
@@ -591,6 +774,485 @@ void ESR_Tool(void)
 
 
 
+/* ************************************************************************
+ *   waveform view
+ * ************************************************************************ */
+
+
+#ifdef SW_WAVEFORM
+
+/*
+ *  waveform view: step response
+ *  - uses probe #1 (pos) and probe #3 (neg)
+ *  - applies a voltage step via Rl to probe #1 and captures the voltage
+ *    at probe #1 at a fixed sampling interval (transient capture)
+ *  - shows final voltage and time constant (63%)
+ *  - right/left keys scroll through samples (time and voltage)
+ *  - long key press changes sampling interval (1-2-5 sequence)
+ */
+
+void Waveform_Tool(void)
+{
+  uint8_t           Run = 1;       /* control flag */
+  uint8_t           Test;          /* user feedback */
+  uint8_t           n;             /* counter */
+  uint8_t           Index = 0;     /* sample index */
+  uint16_t          Buffer[WAVE_SAMPLES];    /* samples */
+  uint16_t          U_0;           /* start voltage (ADC counts) */
+  uint16_t          U_th;          /* 63% threshold (ADC counts) */
+  uint32_t          Interval = 1000;    /* sampling interval (s) */
+  uint32_t          Value;         /* temp. value */
+
+  /* show tool info */
+  LCD_Clear();
+  #ifdef UI_COLORED_TITLES
+    /* display: Waveform */
+    Display_ColoredEEString(Waveform_str, COLOR_TITLE);
+  #else
+    Display_EEString(Waveform_str);     /* display: Waveform */
+  #endif
+  ProbePinout(PROBES_ESR);         /* show probes used */
+  Display_Minus();                 /* display "no value" */
+
+  UpdateProbes2(PROBE_1, PROBE_3); /* update probes */
+
+  /* no capture yet */
+  n = 0;
+  while (n < WAVE_SAMPLES)
+  {
+    Buffer[n] = 0;
+    n++;
+  }
+
+  while (Run > 0)
+  {
+    /*
+     *  short key press -> capture
+     *  long key press -> change interval
+     *  right/left key -> next/previous sample
+     *  two short key presses -> exit tool
+     */
+
+    /* wait for user feedback */
+    Test = TestKey(0, CURSOR_BLINK | CHECK_KEY_TWICE | CHECK_BAT);
+    LCD_ClearLine2();                   /* update line #2 */
+
+    if (Test == KEY_TWICE)              /* two short key presses */
+    {
+      Run = 0;                          /* end loop */
+    }
+    else if (Test == KEY_LONG)          /* long key press */
+    {
+      /* next interval: 200s - 50ms */
+      if (Interval == 50000) Interval = 200;
+      else if ((Interval == 200) || (Interval == 2000) || (Interval == 20000))
+      {
+        Interval *= 5;
+        Interval /= 2;
+      }
+      else Interval *= 2;
+
+      Display_Value(Interval, -6, 's'); /* display interval */
+    }
+    #ifdef HW_KEYS
+    else if ((Test == KEY_RIGHT) || (Test == KEY_LEFT))    /* scroll */
+    {
+      if (Test == KEY_RIGHT)            /* next sample */
+      {
+        Index++;
+        if (Index >= WAVE_SAMPLES) Index = 0;
+      }
+      else                              /* previous sample */
+      {
+        if (Index == 0) Index = WAVE_SAMPLES;
+        Index--;
+      }
+
+      /* display time and voltage of sample */
+      Display_Value(Interval * (Index + 1), -6, 's');
+      Display_Space();
+      Display_Value(ADC_CaptureU(Buffer[Index], ADC_REF_VCC), -3, 'V');
+    }
+    #endif
+    else                                /* capture */
+    {
+      Display_EEString(Probing_str);    /* display: probing... */
+
+      /* discharge DUT and set probes: Gnd -- probe-3 / probe-1 -- HiZ */
+      DischargeProbes();
+      ADC_PORT = 0;                     /* set ADC port to low */
+      ADC_DDR = Probes.Pin_2;           /* pull down probe-3 directly */
+      R_PORT = 0;                       /* set resistor port to low */
+      R_DDR = 0;                        /* set resistor port to HiZ */
+
+      /* interval in timer ticks (64 MCU cycles) */
+      Value = Interval * MCU_CYCLES_PER_US;
+      Value /= 64;
+
+      /* get start voltage */
+      ADC_CaptureStart(Probes.Ch_1, ADC_REF_VCC, (uint16_t)Value);
+      U_0 = ADC_CaptureSample();
+
+      /* apply step: probe-1 -- Rl -- Vcc */
+      R_PORT = Probes.Rl_1;             /* pull up probe-1 via Rl */
+      R_DDR = Probes.Rl_1;              /* enable pull-up */
+      ADC_CaptureStart(Probes.Ch_1, ADC_REF_VCC, (uint16_t)Value);
+      ADC_Capture(Buffer, WAVE_SAMPLES);     /* take samples */
+      ADC_CaptureStop();
+
+      /* remove step and discharge DUT */
+      R_DDR = 0;                        /* set resistor port to HiZ */
+      R_PORT = 0;                       /* set resistor port to low */
+      DischargeProbes();
+
+      LCD_ClearLine2();                 /* update line #2 */
+      Index = WAVE_SAMPLES - 1;         /* last sample */
+
+      /* display final voltage */
+      Display_Value(ADC_CaptureU(Buffer[Index], ADC_REF_VCC), -3, 'V');
+      Display_Space();
+
+      /*
+       *  time constant: time to reach 63% of final step
+       *  - threshold = U_0 + (U_end - U_0) * 0.632
+       *  - interpolate between samples
+       */
+
+      Test = 0;                         /* no time constant */
+      if (Buffer[Index] > (U_0 + 10))   /* got some step */
+      {
+        Value = Buffer[Index] - U_0;    /* step */
+        Value *= 158;                   /* * 0.632 */
+        Value /= 250;
+        U_th = U_0 + (uint16_t)Value;   /* threshold */
+
+        n = 0;
+        while (n < WAVE_SAMPLES)        /* search threshold */
+        {
+          if (Buffer[n] >= U_th)        /* reached threshold */
+          {
+            /* previous sample (sample n is taken at (n + 1) * interval) */
+            if (n > 0) U_0 = Buffer[n - 1];
+
+            /* interpolate time (in 1/100 of interval) */
+            Value = n * 100UL;
+            Value += ((uint32_t)(U_th - U_0) * 100) / (Buffer[n] - U_0);
+
+            /* convert to s */
+            Value *= Interval;
+            Value /= 100;
+
+            Display_Value(Value, -6, 's');
+            Test = 1;                   /* got time constant */
+            n = WAVE_SAMPLES;           /* end loop */
+          }
+          n++;
+        }
+      }
+
+      if (Test == 0) Display_Minus();   /* no time constant */
+    }
+  }
+}
+
+#endif
+
+
+
+/* ************************************************************************
+ *   binning
+ * ************************************************************************ */
+
+
+#ifdef SW_BINNING
+
+/* local constants for bins */
+#define BIN_NONE         255            /* no part */
+
+
+/*
+ *  get values of interest of detected component
+ *  - BJT: hFE and V_BE (V_f of B-E junction)
+ *  - FET/IGBT: V_th
+ *  - diode: V_f
+ *
+ *  requires:
+ *  - Bin: pointer to bin data
+ */
+
+void GetBinValues(Bin_Type *Bin)
+{
+  Diode_Type        *Diode;        /* pointer to diode */
+  int16_t           Value;         /* temp. value */
+
+  Bin->Comp.Found = Check.Found;   /* component */
+  Bin->Value_1 = 0;                /* reset values */
+  Bin->Value_2 = 0;
+
+  switch (Check.Found)
+  {
+    case COMP_BJT:            /* BJT */
+      /* hFE */
+      if (Semi.F_1 > UINT16_MAX) Bin->Value_1 = UINT16_MAX;
+      else Bin->Value_1 = (uint16_t)Semi.F_1;
+
+      /* V_BE */
+      if (Check.Type & TYPE_NPN)        /* NPN */
+      {
+        Diode = SearchDiode(Semi.A, Semi.C);
+      }
+      else                              /* PNP */
+      {
+        Diode = SearchDiode(Semi.C, Semi.A);
+      }
+      if (Diode) Bin->Value_2 = Diode->V_f;
+      break;
+
+    case COMP_FET:            /* FET */
+    case COMP_IGBT:           /* IGBT */
+      /* V_th (negative for p-channel) */
+      Value = Semi.U_2;
+      if (Value < 0) Value = -Value;
+      Bin->Value_1 = (uint16_t)Value;
+      break;
+
+    case COMP_DIODE:          /* diode */
+      Bin->Value_1 = Diodes[0].V_f;
+      break;
+  }
+}
+
+
+
+/*
+ *  get bin of a value
+ *  - bin #1: within BIN_TOLERANCE
+ *  - bin #2: within 2 * BIN_TOLERANCE
+ *  - bin #3: within 4 * BIN_TOLERANCE
+ *
+ *  requires:
+ *  - Value: measured value
+ *  - Ref: reference value
+ *
+ *  returns:
+ *  - bin number (1-3)
+ *  - 0 if out of range
+ */
+
+uint8_t GetBin(uint16_t Value, uint16_t Ref)
+{
+  uint8_t           Bin = 1;       /* bin number */
+  uint32_t          Diff;          /* difference (0.01) */
+  uint32_t          Limit;         /* tolerance */
+
+  if (Ref == 0) return Bin;        /* no reference value */
+
+  /* difference in 1% of reference value */
+  if (Value > Ref) Diff = Value - Ref;
+  else Diff = Ref - Value;
+  Diff *= 100;
+
+  Limit = (uint32_t)Ref * BIN_TOLERANCE;
+  while (Bin <= 3)
+  {
+    if (Diff <= Limit) return Bin;      /* within tolerance */
+    Limit *= 2;                         /* next bin */
+    Bin++;
+  }
+
+  return 0;
+}
+
+
+
+/*
+ *  display values of interest
+ *
+ *  requires:
+ *  - Bin: pointer to bin data
+ */
+
+void Show_BinValues(Bin_Type *Bin)
+{
+  switch (Bin->Comp.Found)
+  {
+    case COMP_BJT:            /* BJT */
+      Display_EEString_Space(h_FE_str);      /* display: hFE */
+      Display_Value2(Bin->Value_1);          /* display hFE */
+      Display_Space();
+      Display_Value(Bin->Value_2, -3, 'V');  /* display V_BE */
+      break;
+
+    case COMP_FET:            /* FET */
+    case COMP_IGBT:           /* IGBT */
+      Display_EEString_Space(Vth_str);       /* display: Vth */
+      Display_Value(Bin->Value_1, -3, 'V');  /* display V_th */
+      break;
+
+    case COMP_DIODE:          /* diode */
+      Display_EEString_Space(Vf_str);        /* display: Vf */
+      Display_Value(Bin->Value_1, -3, 'V');  /* display V_f */
+      break;
+
+    default:                  /* no reference */
+      Display_Minus();
+      break;
+  }
+}
+
+
+
+/*
+ *  binning: sort parts by comparing them with a reference part
+ *  - reference is stored in the EEPROM
+ *  - checks only for the learned type and pinout (fast)
+ *  - display: line #2 reference, line #3 part, line #4 bin
+ *  - signals bin by color and buzzer when a part is inserted
+ */
+
+void Binning_Tool(void)
+{
+  uint8_t           Run = 1;       /* control flag */
+  uint8_t           Test;          /* user feedback */
+  uint8_t           Bin;           /* bin number */
+  #ifdef HW_BUZZER
+  uint8_t           Last = BIN_NONE;    /* last bin */
+  #endif
+  Bin_Type          Ref;           /* reference */
+  Bin_Type          Part;          /* current part */
+
+  /* show tool info */
+  LCD_Clear();
+  #ifdef UI_COLORED_TITLES
+    /* display: Binning */
+    Display_ColoredEEString(Binning_str, COLOR_TITLE);
+  #else
+    Display_EEString(Binning_str);      /* display: Binning */
+  #endif
+
+  /* get reference from EEPROM */
+  eeprom_read_block((void *)&Ref, (const void *)&NV_Bin, sizeof(Bin_Type));
+  LCD_ClearLine2();
+  Show_BinValues(&Ref);            /* display reference */
+
+  while (Run > 0)
+  {
+    /*
+     *  long key press -> learn reference part
+     *  two short key presses -> exit tool
+     */
+
+    /* check for user feedback */
+    Test = TestKey(100, CHECK_KEY_TWICE | CHECK_BAT);
+
+    if (Test == KEY_TWICE)              /* two short key presses */
+    {
+      Run = 0;                          /* end loop */
+    }
+    else if (Test == KEY_LONG)          /* long key press */
+    {
+      /* learn reference part */
+      LCD_ClearLine2();
+      Display_EEString(Probing_str);    /* display: probing... */
+      SearchComponent();                /* full component search */
+
+      LCD_ClearLine2();
+      if (LearnComponent(&Ref.Comp))    /* supported component */
+      {
+        GetBinValues(&Ref);             /* get reference values */
+        eeprom_write_block((void *)&Ref, (void *)&NV_Bin, sizeof(Bin_Type));
+      }
+      else                              /* unsupported */
+      {
+        Ref.Comp.Found = COMP_NONE;     /* no reference */
+      }
+      Show_BinValues(&Ref);             /* display reference */
+
+      #ifdef HW_BUZZER
+      Last = BIN_NONE;                  /* reset bin */
+      #endif
+    }
+    else                                /* check part */
+    {
+      Bin = BIN_NONE;                   /* no part */
+
+      ResetCheck();                     /* reset detection */
+      DischargeProbes();                /* try to discharge DUT */
+
+      if ((Check.Found != COMP_ERROR) &&     /* discharged */
+          CheckLearned(&Ref.Comp))      /* matching type and pinout */
+      {
+        GetBinValues(&Part);            /* get values */
+        Bin = GetBin(Part.Value_1, Ref.Value_1);
+        Test = GetBin(Part.Value_2, Ref.Value_2);
+        /* take worse bin */
+        if ((Bin == 0) || (Test == 0)) Bin = 0;
+        else if (Test > Bin) Bin = Test;
+      }
+      else if (Check.Found != COMP_NONE)     /* wrong part or pinout */
+      {
+        Part.Comp.Found = COMP_NONE;    /* no values */
+        Bin = 0;                        /* out of range */
+      }
+
+      /* update display */
+      LCD_ClearLine3();
+      LCD_ClearLine(4);
+      if (Bin != BIN_NONE)              /* got part */
+      {
+        LCD_CharPos(1, 3);
+        Show_BinValues(&Part);          /* display values */
+
+        /* display bin */
+        LCD_CharPos(1, 4);
+        #ifdef LCD_COLOR
+        if (Bin == 1) UI.PenColor = COLOR_BIN_1;
+        else if (Bin == 2) UI.PenColor = COLOR_BIN_2;
+        else if (Bin == 3) UI.PenColor = COLOR_BIN_3;
+        else UI.PenColor = COLOR_BIN_FAIL;
+        #endif
+        Display_Char('#');
+        Display_Char('0' + Bin);        /* display bin number */
+        #ifdef LCD_COLOR
+        UI.PenColor = COLOR_PEN;        /* reset color */
+        #endif
+
+        #ifdef HW_BUZZER
+        /* buzzer: signal new part */
+        if (Last == BIN_NONE)
+        {
+          #ifdef BUZZER_ACTIVE
+          /* active buzzer: short beep (20ms) for bin, long one for fail */
+          BUZZER_PORT |= (1 << BUZZER_CTRL);      /* enable: set pin high */
+          if (Bin > 0) MilliSleep(20);            /* wait for 20 ms */
+          else MilliSleep(200);                   /* wait for 200 ms */
+          BUZZER_PORT &= ~(1 << BUZZER_CTRL);     /* disable: set pin low */
+          #endif
+
+          #ifdef BUZZER_PASSIVE
+          /* passive buzzer: high freq for bin, low freq for fail */
+          if (Bin > 0) PassiveBuzzer(BUZZER_FREQ_HIGH);
+          else PassiveBuzzer(BUZZER_FREQ_LOW);
+          #endif
+        }
+
+        Last = Bin;                     /* save bin */
+        #endif
+      }
+      #ifdef HW_BUZZER
+      else Last = BIN_NONE;             /* no part */
+      #endif
+    }
+  }
+}
+
+/* clean up local constants for bins */
+#undef BIN_NONE
+
+#endif
+
+
+
 /* ************************************************************************
  *   rotary encoder check
  * ************************************************************************ */
@@ -1209,6 +1871,94 @@ void OptoCoupler_Tool(void)
  * ************************************************************************ */
 
 
+#ifdef SW_CAP_LEAK_TREND
+
+/*
+ *  predict final leakage current of a capacitor
+ *  - assumes an exponential decay towards the final current:
+ *    I(t) = I_end + A * exp(-t / tau)
+ *  - takes three equally spaced points from the log (oldest, middle
+ *    and newest) and extrapolates (Aitken's delta-squared):
+ *    I_end = I2 - (I1 - I2)^2 / ((I0 - I1) - (I1 - I2))
+ *  - time to stable: excess current drops below 5% of I_end,
+ *    decay factor per step: q = (I1 - I2) / (I0 - I1)
+ *
+ *  requires:
+ *  - Log: pointer to log (ring buffer)
+ *  - Next: index of next log entry
+ *  - Count: number of valid log entries
+ *  - I_end: pointer to final current (0.1nA)
+ *  - Time: pointer to time to stable (s)
+ *
+ *  returns:
+ *  - 1 on success
+ *  - 0 if there's no decaying trend (yet)
+ */
+
+uint8_t LeakTrend(Leak_Type *Log, uint8_t Next, uint8_t Count, uint32_t *I_end, uint16_t *Time)
+{
+  uint8_t           n;             /* index */
+  uint8_t           k;             /* spacing */
+  uint8_t           Steps = 0;     /* steps to stable */
+  uint16_t          Step;          /* time per step (s) */
+  uint32_t          I0, I1, I2;    /* currents (oldest to newest) */
+  uint32_t          D1, D2;        /* differences */
+  uint32_t          Excess;        /* excess current */
+  uint32_t          Q;             /* decay factor (1/256) */
+
+  if (Count < 3) return 0;         /* not enough points */
+
+  /* get points: newest, middle and oldest */
+  k = (Count - 1) / 2;                       /* spacing */
+  n = (Next - 1) & (LEAK_POINTS - 1);        /* newest */
+  I2 = Log[n].I;
+  Step = Log[n].Time;
+  n = (n - k) & (LEAK_POINTS - 1);           /* middle */
+  I1 = Log[n].I;
+  Step -= Log[n].Time;                       /* time for spacing */
+  n = (n - k) & (LEAK_POINTS - 1);           /* oldest */
+  I0 = Log[n].I;
+
+  /* current has to decay */
+  if ((I0 <= I1) || (I1 < I2)) return 0;
+  D1 = I0 - I1;
+  D2 = I1 - I2;
+  if (D2 >= D1) return 0;          /* not slowing down */
+
+  /* excess current of newest point: (I1 - I2)^2 / (D1 - D2) */
+  if (D2 <= UINT16_MAX)            /* prevent overflow */
+  {
+    Excess = D2 * D2;
+    Excess /= D1 - D2;
+  }
+  else                             /* large values */
+  {
+    Excess = D2 / (D1 - D2);
+    Excess *= D2;
+  }
+  if (Excess > I2) Excess = I2;    /* limit to I_end = 0 */
+  I2 -= Excess;                    /* I_end */
+  *I_end = I2;
+
+  /* steps until excess drops below 5% of I_end */
+  Q = (D2 * 256) / D1;             /* decay factor */
+  I2 /= 20;                        /* 5% of I_end */
+  if (I2 == 0) I2 = 1;             /* min. 0.1nA */
+  while ((Excess > I2) && (Steps < 100))
+  {
+    Excess *= Q;
+    Excess /= 256;
+    Steps++;
+  }
+  *Time = Steps * Step;
+
+  return 1;
+}
+
+#endif
+
+
+
 #ifdef SW_CAP_LEAKAGE
 
 /*
@@ -1224,11 +1974,23 @@ void Cap_Leakage(void)
   uint8_t           Mode;               /* mode */
   uint16_t          U1 = 0;             /* voltage #1 */
   uint32_t          Value;              /* temp. value */
+  #ifdef SW_CAP_LEAK_TREND
+  Leak_Type         Log[LEAK_POINTS];   /* log (ring buffer) */
+  uint8_t           Next = 0;           /* index of next log entry */
+  uint8_t           Count = 0;          /* number of log entries */
+  uint16_t          Time = 0;           /* time since start (s) */
+  uint16_t          t_Stable;           /* time to stable (s) */
+  uint32_t          I_end;              /* final current */
+  uint8_t           Trend;              /* flag for prediction */
+  #endif
 
   /* local constants for Flag (bitfield) */
   #define RUN_FLAG            0b00000001     /* run flag */
   #define CHANGED_MODE        0b00000100     /* mode has changed */
 
+  /* local constants for trend */
+  #define TREND_STEP          2         /* log interval (s), see TestKey() */
+
   /* local constants for Mode */
   #define MODE_NONE           0         /* no mode (show pinout) */
   #define MODE_HIGH           1         /* charge cap: high current */
@@ -1266,6 +2028,9 @@ void Cap_Leakage(void)
           /* probe-1: Vcc / probe-3: Gnd */
           Show_SimplePinout('+', 0, '-');
           LCD_ClearLine(3);             /* clear line #3 */
+          #ifdef SW_CAP_LEAK_TREND
+          if (UI.CharMax_Y >= 4) LCD_ClearLine(4);     /* clear line #4 */
+          #endif
           break;
 
         case MODE_HIGH:            /* charge cap with high current (Rl) */
@@ -1288,6 +2053,14 @@ void Cap_Leakage(void)
           /* set probes: probe-3 -- Rh -- Gnd / probe-1 -- Vcc */
           /* simply switch pull-down resistor Rl to Rh */
           R_DDR = Probes.Rh_3;          /* select Rh for probe-3 */
+
+          #ifdef SW_CAP_LEAK_TREND
+          /* start new log */
+          Next = 0;
+          Count = 0;
+          Time = 0;
+          Trend = 0;
+          #endif
           break;
 
         case MODE_DISCHARGE:       /* discharge cap */
@@ -1335,19 +2108,70 @@ void Cap_Leakage(void)
 
         case MODE_LOW:             /* charge cap with low current (Rh) */
           /* voltage across Rh at probe-3 (ignore RiL) */
+          #ifdef SW_LEAKAGE_AUTO
+          /* integrate until stable */
+          Value = ReadU_Integrated(Probes.Ch_3);   /* in V */
+          U1 = Value / 1000;                 /* in mV */
+          #else
           U1 = ReadU(Probes.Ch_3);           /* read voltage at probe-3 */
+          #endif
 
+          #ifdef SW_LEAKAGE_AUTO
+          if (Value > 250)              /* minimum exceeded (250V) */
+          #else
           if (U1 > CAP_DISCHARGED)      /* minimum exceeded */
+          #endif
           {
             /* calculate current: I = U / R */
+            #ifdef SW_LEAKAGE_AUTO
+            Value *= 100;                      /* scale to 0.01 V */
+            Value /= (R_HIGH / 100);           /* 0.01 V / 100 Ohms = 0.1 nA */
+            #else
             Value = U1;                        /* in mV */
             Value *= 10000;                    /* scale to 0.1 V */
             Value /= (R_HIGH / 1000);          /* 0.1 V / kOhms = 0.1 nA */
+            #endif
             Display_Value(Value, -10, 'A');    /* display current */
+
+            #ifdef SW_CAP_LEAK_TREND
+            /* log current and voltage at cap */
+            Log[Next].Time = Time;
+            Log[Next].U = Cfg.Vcc - U1;
+            Log[Next].I = Value;
+            Next = (Next + 1) & (LEAK_POINTS - 1);
+            if (Count < LEAK_POINTS) Count++;
+
+            /* predict final current */
+            Trend = LeakTrend(Log, Next, Count, &I_end, &t_Stable);
+
+            #ifdef UI_SERIAL_COPY
+            /* send log point: time, voltage, current (and prediction) */
+            Display_Serial_Only();           /* switch output to serial */
+            Display_Value(Time, 0, 's');
+            Display_Space();
+            Display_Value(Cfg.Vcc - U1, -3, 'V');
+            Display_Space();
+            Display_Value(Value, -10, 'A');
+            if (Trend)
+            {
+              Display_Space();
+              Display_Value(I_end, -10, 'A');
+              Display_Space();
+              Display_Value(t_Stable, 0, 's');
+            }
+            Serial_NewLine();
+            Display_LCD_Only();              /* switch output back to display */
+            #endif
+
+            Time += TREND_STEP;              /* next log point */
+            #endif
           }
           else                          /* in the noise floor */
           {
             Display_Minus();
+            #ifdef SW_CAP_LEAK_TREND
+            Trend = 0;                  /* no prediction */
+            #endif
           }
           break;
 
@@ -1375,6 +2199,24 @@ void Cap_Leakage(void)
         Display_Value(U1, -3, 'V');          /* display voltage */
         Display_Char(')');
       }
+
+      #ifdef SW_CAP_LEAK_TREND
+      /* display prediction in line #4 */
+      if ((Mode == MODE_LOW) && (UI.CharMax_Y >= 4))
+      {
+        LCD_ClearLine(4);
+        if (Trend)                      /* got prediction */
+        {
+          LCD_CharPos(1, 4);
+          Display_Char('-');            /* display: -> */
+          Display_Char('>');
+          Display_Space();
+          Display_Value(I_end, -10, 'A');    /* final current */
+          Display_Space();
+          Display_Value(t_Stable, 0, 's');   /* time to stable */
+        }
+      }
+      #endif
     }
 
 
@@ -1436,6 +2278,9 @@ void Cap_Leakage(void)
   /* local constants for Flag */
   #undef RUN_FLAG
   #undef CHANGED_MODE
+
+  /* local constants for trend */
+  #undef TREND_STEP
 }
 
 #endif
@@ -1474,6 +2319,9 @@ void Monitor_R(void)
   R1 = &Resistors[0];                   /* pointer to first resistor */
   /* increase number of samples to lower spread of measurement values */
   Cfg.Samples = 100;                    /* perform 100 ADC samples */
+  #ifdef SW_MONITOR_TRACK
+  Check.Resistors = 0;                  /* reset resistor counter */
+  #endif
 
 
   /*
@@ -1483,8 +2331,14 @@ void Monitor_R(void)
   while (Flag)
   {
     /* measure R and display value */
-    Check.Resistors = 0;                /* reset resistor counter */
-    CheckResistor();                    /* check for resistor */
+    #ifdef SW_MONITOR_TRACK
+    /* track known resistor, or run full check */
+    if ((Check.Resistors != 1) || (TrackResistor(R1) == 0))
+    #endif
+    {
+      Check.Resistors = 0;              /* reset resistor counter */
+      CheckResistor();                  /* check for resistor */
+    }
     LCD_ClearLine2();                   /* clear line #2 */
 
     if (Check.Resistors == 1)           /* found resistor */
@@ -1497,8 +2351,8 @@ void Monitor_R(void)
       Display_Minus();                  /* display: nothing */
     }
 
-    /* user feedback (1s delay) */
-    Test = TestKey(1000, CHECK_KEY_TWICE | CHECK_BAT | CURSOR_STEADY);
+    /* user feedback (1s delay, or 250ms when tracking) */
+    Test = TestKey(MONITOR_WAIT, CHECK_KEY_TWICE | CHECK_BAT | CURSOR_STEADY);
 
     if (Test == KEY_TWICE)         /* two short key presses */
     {
@@ -1543,6 +2397,9 @@ void Monitor_C(void)
   /* init */
   Check.Diodes = 0;                     /* reset diode counter */
   Cap = &Caps[0];                       /* pointer to first cap */
+  #ifdef SW_MONITOR_TRACK
+  Check.Found = COMP_NONE;              /* no component */
+  #endif
 
 
   /*
@@ -1566,9 +2423,15 @@ void Monitor_C(void)
     #endif
 
     /* measure and display C */
-    Check.Found = COMP_NONE;                 /* no component */
-    /* keep probe order of normal probing cycle */
-    MeasureCap(PROBE_3, PROBE_1, 0);         /* measure capacitance */
+    #ifdef SW_MONITOR_TRACK
+    /* track known cap, or run full check */
+    if ((Check.Found != COMP_CAPACITOR) || (TrackCap(Cap) == 0))
+    #endif
+    {
+      Check.Found = COMP_NONE;               /* no component */
+      /* keep probe order of normal probing cycle */
+      MeasureCap(PROBE_3, PROBE_1, 0);       /* measure capacitance */
+    }
     LCD_ClearLine2();                        /* clear line #2 */
 
     if (Check.Found == COMP_CAPACITOR)       /* found cap */
@@ -1595,8 +2458,8 @@ void Monitor_C(void)
       Display_Minus();                       /* display: nothing */
     }
 
-    /* user feedback (2s delay) */
-    Test = TestKey(2000, CHECK_KEY_TWICE | CHECK_BAT | CURSOR_STEADY);
+    /* user feedback (2s delay, or 500ms when tracking) */
+    Test = TestKey(MONITOR_WAIT * 2, CHECK_KEY_TWICE | CHECK_BAT | CURSOR_STEADY);
 
     if (Test == KEY_TWICE)         /* two short key presses */
     {
@@ -1633,6 +2496,9 @@ void Monitor_L(void)
 
   /* init */
   R1 = &Resistors[0];                   /* pointer to first resistor */
+  #ifdef SW_MONITOR_TRACK
+  Check.Resistors = 0;                  /* reset resistor counter */
+  #endif
 
 
   /*
@@ -1654,9 +2520,15 @@ void Monitor_L(void)
     #endif
 
     /* measure R */
-    UpdateProbes2(PROBE_1, PROBE_3);    /* update probes */
-    Check.Resistors = 0;                /* reset resistor counter */
-    CheckResistor();                    /* check for resistor */
+    #ifdef SW_MONITOR_TRACK
+    /* track known resistor, or run full check */
+    if ((Check.Resistors != 1) || (TrackResistor(R1) == 0))
+    #endif
+    {
+      UpdateProbes2(PROBE_1, PROBE_3);  /* update probes */
+      Check.Resistors = 0;              /* reset resistor counter */
+      CheckResistor();                  /* check for resistor */
+    }
     LCD_ClearLine2();                   /* clear line #2 */
 
     if (Check.Resistors == 1)           /* found resistor */
@@ -1681,8 +2553,8 @@ void Monitor_L(void)
       Display_Minus();                  /* display: nothing */
     }
 
-    /* user feedback (1s delay) */
-    Test = TestKey(1000, CHECK_KEY_TWICE | CHECK_BAT | CURSOR_STEADY);
+    /* user feedback (1s delay, or 250ms when tracking) */
+    Test = TestKey(MONITOR_WAIT, CHECK_KEY_TWICE | CHECK_BAT | CURSOR_STEADY);
 
     if (Test == KEY_TWICE)         /* two short key presses */
     {
@@ -1745,9 +2617,15 @@ void Monitor_RCL(void)
       Cfg.Samples = 100;                /* perform 100 ADC samples */
 
       /* measure R */
-      UpdateProbes2(PROBE_1, PROBE_3);       /* update probes */
-      Check.Resistors = 0;                   /* reset resistor counter */
-      CheckResistor();                       /* check for resistor */
+      #ifdef SW_MONITOR_TRACK
+      /* track known resistor, or run full check */
+      if ((Run == 1) || (TrackResistor(R1) == 0))
+      #endif
+      {
+        UpdateProbes2(PROBE_1, PROBE_3);     /* update probes */
+        Check.Resistors = 0;                 /* reset resistor counter */
+        CheckResistor();                     /* check for resistor */
+      }
 
       if (Check.Resistors == 1)         /* found resistor */
       {
@@ -1775,8 +2653,14 @@ void Monitor_RCL(void)
     {
       /* measure capacitance */
 
-      /* keep probe order of normal probing cycle */
-      MeasureCap(PROBE_3, PROBE_1, 0);       /* measure capacitance */
+      #ifdef SW_MONITOR_TRACK
+      /* track known cap, or run full check */
+      if ((Run != COMP_CAPACITOR) || (TrackCap(Cap) == 0))
+      #endif
+      {
+        /* keep probe order of normal probing cycle */
+        MeasureCap(PROBE_3, PROBE_1, 0);     /* measure capacitance */
+      }
 
       if (Check.Found == COMP_CAPACITOR)     /* found cap */
       {
@@ -1828,8 +2712,8 @@ void Monitor_RCL(void)
     }
 
 
-    /* user feedback (1s delay) */
-    Test = TestKey(1000, CHECK_KEY_TWICE | CHECK_BAT | CURSOR_STEADY);
+    /* user feedback (1s delay, or 250ms when tracking) */
+    Test = TestKey(MONITOR_WAIT, CHECK_KEY_TWICE | CHECK_BAT | CURSOR_STEADY);
 
     if (Test == KEY_TWICE)         /* two short key presses */
     {
@@ -1868,6 +2752,9 @@ void Monitor_RL(void)
   R1 = &Resistors[0];                   /* pointer to first resistor */
   /* increase number of samples to lower spread of measurement values */
   Cfg.Samples = 100;                    /* perform 100 ADC samples */
+  #ifdef SW_MONITOR_TRACK
+  Check.Resistors = 0;                  /* reset resistor counter */
+  #endif
 
 
   /*
@@ -1877,9 +2764,15 @@ void Monitor_RL(void)
   while (Flag)
   {
     /* measure R and display value */
-    UpdateProbes2(PROBE_1, PROBE_3);    /* update probes */
-    Check.Resistors = 0;                /* reset resistor counter */
-    CheckResistor();                    /* check for resistor */
+    #ifdef SW_MONITOR_TRACK
+    /* track known resistor, or run full check */
+    if ((Check.Resistors != 1) || (TrackResistor(R1) == 0))
+    #endif
+    {
+      UpdateProbes2(PROBE_1, PROBE_3);  /* update probes */
+      Check.Resistors = 0;              /* reset resistor counter */
+      CheckResistor();                  /* check for resistor */
+    }
     LCD_ClearLine2();                   /* clear line #2 */
 
     if (Check.Resistors == 1)           /* found resistor */
@@ -1899,8 +2792,8 @@ void Monitor_RL(void)
       Display_Minus();                  /* display: nothing */
     }
 
-    /* user feedback (1s delay) */
-    Test = TestKey(1000, CHECK_KEY_TWICE | CHECK_BAT | CURSOR_STEADY);
+    /* user feedback (1s delay, or 250ms when tracking) */
+    Test = TestKey(MONITOR_WAIT, CHECK_KEY_TWICE | CHECK_BAT | CURSOR_STEADY);
 
     if (Test == KEY_TWICE)         /* two short key presses */
     {
@@ -1942,6 +2835,20 @@ void LogicProbe(void)
   uint16_t          U_low = 0;          /* voltage threshold for low */
   uint16_t          U_high = 0;         /* voltage threshold for high */
   uint32_t          Value;              /* temporary value */
+  #ifdef LOGIC_PROBE_PULSE
+  uint8_t           Sample;             /* ADC reading (8 bit) */
+  uint8_t           Low;                /* threshold for low (ADC) */
+  uint8_t           High;               /* threshold for high (ADC) */
+  uint8_t           Level;              /* logic level of signal */
+  uint16_t          n;                  /* sample counter */
+  uint16_t          Edges;              /* number of edges */
+  uint16_t          Rises;              /* number of rising edges */
+  uint16_t          Highs = 0;          /* number of high samples */
+  uint16_t          FirstRise = 0;      /* sample of first rising edge */
+  uint16_t          FirstHighs = 0;     /* high samples at first rising edge */
+  uint16_t          LastRise = 0;       /* sample of last rising edge */
+  uint16_t          LastHighs = 0;      /* high samples at last rising edge */
+  #endif
 
   /* local constants for Flag (bitfield) */
   #define RUN_FLAG            0b00000001     /* run / otherwise end */
@@ -1954,6 +2861,23 @@ void LogicProbe(void)
   #define ITEM_LOW       2              /* voltage threshold for low */
   #define ITEM_HIGH      3              /* voltage threshold for high */
 
+  #ifdef LOGIC_PROBE_PULSE
+  /* fast sampling: ADC clock of about 500kHz */
+  #if CPU_FREQ == 8000000
+    #define FAST_DIV         16                   /* prescaler */
+    #define FAST_CLOCK_DIV   (1 << ADPS2)         /* register bits */
+  #elif CPU_FREQ == 16000000
+    #define FAST_DIV         32
+    #define FAST_CLOCK_DIV   (1 << ADPS2) | (1 << ADPS0)
+  #elif CPU_FREQ == 20000000
+    #define FAST_DIV         32
+    #define FAST_CLOCK_DIV   (1 << ADPS2) | (1 << ADPS0)
+  #else
+    #error <<< LogicProbe(): no supported MCU clock >>>
+  #endif
+  #define FAST_SAMPLES     4096         /* number of samples (about 100ms) */
+  #endif
+
 
   /*
    *  show info
@@ -2133,6 +3057,101 @@ void LogicProbe(void)
       /* buzzer: no beep */
     }
 
+
+    #ifdef LOGIC_PROBE_PULSE
+
+    /*
+     *  detect pulses
+     *  - ReadU() is too slow to catch pulses, so we run the ADC in
+     *    free running mode with 8 bit resolution and a fast clock
+     *    (a conversion takes 13 ADC clock cycles)
+     *  - samples are compared with the thresholds, a level change
+     *    requires crossing the opposite threshold (hysteresis)
+     *  - any edge signals pulsing, two rising edges give us
+     *    frequency and duty cycle
+     *  - catches pulses longer than the sampling interval
+     *    (26s @8MHz), shorter ones only by chance
+     */
+
+    /* convert thresholds into 8 bit ADC readings (Vcc reference) */
+    /* ADC = U * 256 / Vcc * R2 / (R1 + R2) */
+    Value = (uint32_t)U_low * 256;
+    Value /= Cfg.Vcc;
+    Value *= LOGIC_PROBE_R2;
+    Value /= (LOGIC_PROBE_R1 + LOGIC_PROBE_R2);
+    if (Value > 255) Value = 255;
+    Low = (uint8_t)Value;
+
+    Value = (uint32_t)U_high * 256;
+    Value /= Cfg.Vcc;
+    Value *= LOGIC_PROBE_R2;
+    Value /= (LOGIC_PROBE_R1 + LOGIC_PROBE_R2);
+    if (Value > 255) Value = 255;
+    High = (uint8_t)Value;
+
+    /* start ADC in free running mode (8 bit: left adjusted) */
+    ADMUX = ADC_REF_VCC | (1 << ADLAR) | TP_LOGIC;
+    ADCSRA = (1 << ADEN) | (1 << ADSC) | (1 << ADATE) | (1 << ADIF) | FAST_CLOCK_DIV;
+
+    Level = 2;                     /* unknown level */
+    Edges = 0;
+    Rises = 0;
+    Highs = 0;
+    n = 0;
+
+    while (n < FAST_SAMPLES)       /* sampling loop */
+    {
+      while (! (ADCSRA & (1 << ADIF)));     /* wait for conversion */
+      Sample = ADCH;                        /* get 8 bit reading */
+      ADCSRA |= (1 << ADIF);                /* clear flag */
+
+      if (Sample >= High)          /* high */
+      {
+        if (Level == 0)            /* rising edge */
+        {
+          Edges++;
+          Rises++;
+
+          if (Rises == 1)          /* first rising edge */
+          {
+            FirstRise = n;
+            FirstHighs = Highs;
+          }
+
+          LastRise = n;
+          LastHighs = Highs;
+        }
+
+        Level = 1;
+      }
+      else if (Sample <= Low)      /* low */
+      {
+        if (Level == 1)            /* falling edge */
+        {
+          Edges++;
+        }
+
+        Level = 0;
+      }
+      /* else: undefined, keep level */
+
+      if (Level == 1) Highs++;     /* count high samples */
+
+      n++;                         /* next sample */
+    }
+
+    /* back to default ADC setup */
+    ADCSRA = (1 << ADEN) | (1 << ADIF) | ADC_CLOCK_DIV;
+    Cfg.Ref = ADC_REF_VCC;              /* update reference source */
+
+    if (Edges > 0)                 /* pulsing */
+    {
+      State = 'P';                 /* P for pulsing */
+    }
+
+    #endif
+
+
     /* display state and voltage */
     LCD_ClearLine(5);                   /* line #5 */
     LCD_CharPos(1, 5);
@@ -2144,7 +3163,38 @@ void LogicProbe(void)
     UI.PenColor = COLOR_PEN;            /* reset color */
     #endif
     Display_Space();
-    Display_Value(U1, -3, 'V');         /* display voltage */
+
+    #ifdef LOGIC_PROBE_PULSE
+    if (Rises >= 2)                     /* got periods */
+    {
+      /*
+       *  frequency and duty cycle
+       *  - f = periods / (samples * t_sample)
+       *    with t_sample = 13 * prescaler / f_MCU
+       *  - duty cycle = high samples / samples
+       */
+
+      n = LastRise - FirstRise;         /* samples of full periods */
+
+      /* frequency in Hz */
+      Value = CPU_FREQ / FAST_DIV;      /* ADC clock */
+      Value *= Rises - 1;               /* * periods */
+      Value /= 13UL * n;                /* / time in ADC clock cycles */
+      Display_Value(Value, 0, 0);       /* display frequency */
+      Display_EEString_Space(Hertz_str);     /* display: Hz */
+
+      /* duty cycle in % */
+      Value = LastHighs - FirstHighs;   /* high samples */
+      Value *= 100;
+      Value += n / 2;                   /* for rounding */
+      Value /= n;
+      Display_Value(Value, 0, '%');     /* display duty cycle */
+    }
+    else
+    #endif
+    {
+      Display_Value(U1, -3, 'V');       /* display voltage */
+    }
 
 
     /*
@@ -2258,6 +3308,12 @@ void LogicProbe(void)
   /* local constants for Item */
   #undef ITEM_LOW
   #undef ITEM_HIGH
+
+  #ifdef LOGIC_PROBE_PULSE
+  #undef FAST_DIV
+  #undef FAST_CLOCK_DIV
+  #undef FAST_SAMPLES
+  #endif
 }
 
 #endif
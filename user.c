@@ -42,18 +42,79 @@
  * ************************************************************************ */
 
 
+/*
+ *  divide value by 10
+ *  - shift and add (no division, no 64 bit multiplication)
+ *  - exact for the full 32 bit range
+ *
+ *  requires:
+ *  - Value: dividend
+ *
+ *  returns:
+ *  - Value / 10 (rounded down)
+ */
+
+uint32_t Div10(uint32_t Value)
+{
+  uint32_t          Q;             /* quotient */
+  uint32_t          R;             /* remainder */
+
+  /* Q = Value * 0.8 / 8 (approximation of 0.1 by 0.000110011...b) */
+  Q = (Value >> 1) + (Value >> 2);
+  Q += (Q >> 4);
+  Q += (Q >> 8);
+  Q += (Q >> 16);
+  Q >>= 3;
+
+  /* correct approximation error (off by one at most) */
+  R = Value - (((Q << 2) + Q) << 1);   /* Value - Q * 10 */
+  if (R > 9) Q++;
+
+  return Q;
+}
+
+
+
+/*
+ *  get power of ten
+ *
+ *  requires:
+ *  - Exp: exponent (0-9)
+ *
+ *  returns:
+ *  - 10^Exp
+ */
+
+uint32_t Power10(uint8_t Exp)
+{
+  uint32_t          Value = 1;     /* return value */
+
+  while (Exp > 0)
+  {
+    Value *= 10;
+    Exp--;
+  }
+
+  return Value;
+}
+
+
+
 /*
  *  get number of digits of a value
+ *  - compares with powers of ten (no division)
  */
 
 uint8_t NumberOfDigits(uint32_t Value)
 {
   uint8_t           Counter = 1;   /* return value */
+  uint32_t          Limit = 10;    /* next power of ten */
 
-  while (Value >= 10)
+  while (Value >= Limit)
   {
-    Value /= 10;
     Counter++;
+    if (Counter == 10) break;      /* max. 10 digits (prevent overflow) */
+    Limit *= 10;
   }
 
   return Counter;
@@ -61,6 +122,50 @@ uint8_t NumberOfDigits(uint32_t Value)
 
 
 
+/*
+ *  convert unsigned value into string of decimal digits
+ *  - subtracts powers of ten (no division)
+ *
+ *  requires:
+ *  - Value: unsigned value
+ *  - Buffer: pointer to string buffer (min. 11 chars)
+ *
+ *  returns:
+ *  - number of digits
+ */
+
+uint8_t ValueToString(uint32_t Value, char *Buffer)
+{
+  uint8_t           Length;        /* number of digits */
+  uint8_t           n = 0;         /* counter */
+  char              Digit;         /* digit */
+  uint32_t          Power;         /* power of ten for current digit */
+
+  Length = NumberOfDigits(Value);
+  Power = Power10(Length - 1);     /* power of ten for first digit */
+
+  while (n < Length)
+  {
+    Digit = '0';
+
+    while (Value >= Power)         /* subtract power of ten */
+    {
+      Value -= Power;
+      Digit++;
+    }
+
+    Buffer[n] = Digit;             /* save digit */
+    Power = Div10(Power);          /* next lower power of ten */
+    n++;                           /* next digit */
+  }
+
+  Buffer[n] = 0;                   /* terminate string */
+
+  return Length;
+}
+
+
+
 /*
  *  compare two scaled values
  *
@@ -98,19 +203,14 @@ int8_t CmpValue(uint32_t Value1, int8_t Scale1, uint32_t Value2, int8_t Scale2)
     Len1 -= Scale1;           /* just number of digits */
     Len2 -= Scale2;           /* just number of digits */
 
-    while (Len1 > Len2)       /* up-scale Value #2 */
+    if (Len1 > Len2)          /* up-scale Value #2 */
     {
-      Value2 *= 10;
-      Len2++;
-      /* Scale2-- */
+      Value2 *= Power10(Len1 - Len2);
     }
-
-    while (Len2 > Len1)       /* up-scale Value #1 */
+    else                      /* up-scale Value #1 */
     {
-      Value1 *= 10;
-      Len1++;
-      /* Scale1-- */
-    }   
+      Value1 *= Power10(Len2 - Len1);
+    }
 
     Flag = 10;                /* perform direct comparison */
   }
@@ -155,21 +255,35 @@ int8_t CmpValue(uint32_t Value1, int8_t Scale1, uint32_t Value2, int8_t Scale2)
 uint32_t RescaleValue(uint32_t Value, int8_t Scale, int8_t NewScale)
 {
   uint32_t          NewValue;      /* return value */
+  int8_t            Diff;          /* scale difference */
 
   NewValue = Value;           /* take old value */
+  Diff = NewScale - Scale;    /* number of decades */
 
-  while (Scale != NewScale)   /* processing loop */
+  if (Diff > 0)               /* upscale */
   {
-    if (NewScale > Scale)     /* upscale */
+    if (Diff > 9)             /* beyond 32 bit range */
     {
-      NewValue /= 10;
-      Scale++;
+      NewValue = 0;
     }
-    else                      /* downscale */
+    else if (Diff == 1)       /* single decade */
+    {
+      NewValue = Div10(NewValue);
+    }
+    else                      /* several decades: single division */
+    {
+      NewValue /= Power10(Diff);
+    }
+  }
+  else if (Diff < 0)          /* downscale */
+  {
+    while (Diff < -9)         /* beyond range of Power10() */
     {
       NewValue *= 10;
-      Scale--;
+      Diff++;
     }
+
+    NewValue *= Power10(-Diff);
   }
 
   return NewValue;
@@ -1880,6 +1994,8 @@ void AdjustmentMenu(uint8_t Mode)
 #define MENUITEM_DIODE_LED        41
 #define MENUITEM_METER_5VDC       42
 #define MENUITEM_INA226           43
+#define MENUITEM_WAVEFORM         44
+#define MENUITEM_BINNING          45
 
 
 /*
@@ -2131,14 +2247,27 @@ uint8_t PresentMainMenu(void)
     #define ITEM_39      0
   #endif
 
+  #ifdef SW_WAVEFORM
+    #define ITEM_40      1
+  #else
+    #define ITEM_40      0
+  #endif
+
+  #ifdef SW_BINNING
+    #define ITEM_41      1
+  #else
+    #define ITEM_41      0
+  #endif
+
 
   #define ITEMS_PACK_0   (ITEM_01 + ITEM_02 + ITEM_03 + ITEM_04 + ITEM_05 + ITEM_06 + ITEM_07 + ITEM_08 + ITEM_09 + ITEM_10)
   #define ITEMS_PACK_1   (ITEM_11 + ITEM_12 + ITEM_13 + ITEM_14 + ITEM_15 + ITEM_16 + ITEM_17 + ITEM_18 + ITEM_19 + ITEM_20)
   #define ITEMS_PACK_2   (ITEM_21 + ITEM_22 + ITEM_23 + ITEM_24 + ITEM_25 + ITEM_26 + ITEM_27 + ITEM_28 + ITEM_29 + ITEM_30)
-  #define ITEMS_PACK_3   (ITEM_31 + ITEM_32 + ITEM_33 + ITEM_34 + ITEM_35 + ITEM_36 + ITEM_37 + ITEM_38 + ITEM_39)
+  #define ITEMS_PACK_3   (ITEM_31 + ITEM_32 + ITEM_33 + ITEM_34 + ITEM_35 + ITEM_36 + ITEM_37 + ITEM_38 + ITEM_39 + ITEM_40)
+  #define ITEMS_PACK_4   (ITEM_41)
 
   /* number of menu items */
-  #define MENU_ITEMS     (ITEMS_BASIC + ITEMS_PACK_0 + ITEMS_PACK_1 + ITEMS_PACK_2 + ITEMS_PACK_3)
+  #define MENU_ITEMS     (ITEMS_BASIC + ITEMS_PACK_0 + ITEMS_PACK_1 + ITEMS_PACK_2 + ITEMS_PACK_3 + ITEMS_PACK_4)
 
 
   /*
@@ -2209,6 +2338,20 @@ uint8_t PresentMainMenu(void)
   n++;
   #endif
 
+  #ifdef SW_WAVEFORM
+  /* waveform view */
+  Item_Str[n] = (void *)Waveform_str;
+  Item_ID[n] = MENUITEM_WAVEFORM;
+  n++;
+  #endif
+
+  #ifdef SW_BINNING
+  /* binning */
+  Item_Str[n] = (void *)Binning_str;
+  Item_ID[n] = MENUITEM_BINNING;
+  n++;
+  #endif
+
   #ifdef SW_MONITOR_R
   /* monitor R */
   Item_Str[n] = (void *)Monitor_R_str;
@@ -2486,6 +2629,7 @@ uint8_t PresentMainMenu(void)
   #undef ITEMS_PACK_1
   #undef ITEMS_PACK_2
   #undef ITEMS_PACK_3
+  #undef ITEMS_PACK_4
 
   #undef ITEM_01
   #undef ITEM_02
@@ -2526,6 +2670,8 @@ uint8_t PresentMainMenu(void)
   #undef ITEM_37
   #undef ITEM_38
   #undef ITEM_39
+  #undef ITEM_40
+  #undef ITEM_41
 
   return(ID);                 /* return item ID */
 }
@@ -2890,6 +3036,20 @@ uint8_t MainMenu(void)
       break;
     #endif
 
+    #ifdef SW_WAVEFORM
+    /* waveform view */
+    case MENUITEM_WAVEFORM:
+      Waveform_Tool();
+      break;
+    #endif
+
+    #ifdef SW_BINNING
+    /* binning */
+    case MENUITEM_BINNING:
+      Binning_Tool();
+      break;
+    #endif
+
   }
 
   #ifdef POWER_OFF_TIMEOUT
@@ -3005,6 +3165,8 @@ uint8_t MainMenu(void)
 #undef MENUITEM_DIODE_LED
 #undef MENUITEM_METER_5VDC
 #undef MENUITEM_INA226
+#undef MENUITEM_WAVEFORM
+#undef MENUITEM_BINNING
 
 
 
@@ -167,6 +167,14 @@
     const unsigned char CapDischarge_str[] MEM_TYPE = "Vybijeni";
   #endif
 
+  #ifdef SW_WAVEFORM
+    const unsigned char Waveform_str[] MEM_TYPE = "Waveform";
+  #endif
+
+  #ifdef SW_BINNING
+    const unsigned char Binning_str[] MEM_TYPE = "Binning";
+  #endif
+
   #ifdef SW_MONITOR_R
     const unsigned char Monitor_R_str[] MEM_TYPE = "R Monitor";
   #endif
@@ -96,6 +96,31 @@
     uint8_t         IR_Code[IR_CODE_BYTES];  /* raw data */
   #endif
 
+  #ifdef SW_REPEAT_TYPE
+    Learn_Type      LastComp;                /* last component */
+  #endif
+
+  #ifdef SW_HFE_SWEEP
+    Sweep_Type      HFE_Sweep[HFE_POINTS];   /* hFE sweep table */
+    uint8_t         HFE_Points;              /* number of valid points */
+  #endif
+
+  #ifdef SW_DIODE_CURVE
+    Curve_Type      DiodeCurve[CURVE_POINTS];     /* diode I/V curve */
+    uint8_t         CurvePoints;             /* number of valid points */
+    Shockley_Type   DiodeFit;                /* Shockley parameters */
+  #endif
+
+  #ifdef SW_SCR_CURRENTS
+    SCR_Type        SCR;                     /* thyristor/TRIAC currents */
+  #endif
+
+  #if defined (FUNC_EVALUE) || defined (FUNC_COLORCODE) || defined (FUNC_EIA96)
+    /* E series lookup cache (last lookup per E series) */
+    uint16_t        ENorm_Value[NUM_E_CACHE];     /* value (100-999) */
+    uint8_t         ENorm_Index[NUM_E_CACHE];     /* index of higher norm value */
+  #endif
+
 
   /*
    *  NVRAM values with their defaults
@@ -132,6 +157,16 @@
     const Touch_Type    NV_Touch EEMEM = {0, 0, 0, 0, 0};
   #endif
 
+  #ifdef SW_IR_LEARN
+    /* learned IR codes */
+    const IR_Slot_Type  NV_IR_Slots[IR_SLOTS] EEMEM = {{0}};
+  #endif
+
+  #ifdef SW_BINNING
+    /* binning reference */
+    const Bin_Type      NV_Bin EEMEM = {{COMP_NONE, 0, 0, 0, 0}, 0, 0};
+  #endif
+
 
   /*
    *  constant strings
@@ -240,6 +275,9 @@
     const unsigned char IR_SIRC_12_str[] MEM_TYPE = "SIRC-12";
     const unsigned char IR_SIRC_15_str[] MEM_TYPE = "SIRC-15";
     const unsigned char IR_SIRC_20_str[] MEM_TYPE = "SIRC-20";
+    #ifdef SW_IR_LEARN
+      const unsigned char IR_Raw_str[] MEM_TYPE = "Raw";
+    #endif
   #endif
 
   #ifdef SW_OPTO_COUPLER
@@ -314,6 +352,22 @@
     const unsigned char INA226_str[] MEM_TYPE = "INA226";
   #endif
 
+  #ifdef SW_DIODE_CURVE
+    const unsigned char R_s_str[] MEM_TYPE = "Rs";
+    const unsigned char Schottky_str[] MEM_TYPE = "Schottky";
+    const unsigned char Silicon_str[] MEM_TYPE = "Si";
+    const unsigned char LED_IR_str[] MEM_TYPE = "LED IR";
+    const unsigned char LED_Red_str[] MEM_TYPE = "LED R";
+    const unsigned char LED_YG_str[] MEM_TYPE = "LED Y/G";
+    const unsigned char LED_BW_str[] MEM_TYPE = "LED B/W";
+  #endif
+
+  #ifdef SW_SCR_CURRENTS
+    const unsigned char I_GT_str[] MEM_TYPE = "I_GT";
+    const unsigned char I_Latch_str[] MEM_TYPE = "I_L";
+    const unsigned char I_Hold_str[] MEM_TYPE = "I_H";
+  #endif
+
 
   /* component symbols */
   const unsigned char Cap_str[] MEM_TYPE = {'-', LCD_CHAR_CAP, '-',0};
@@ -386,6 +440,16 @@
       const unsigned char Cmd_V_F_clamp_str[] MEM_TYPE = "V_F_clamp";
     #endif
     const unsigned char Cmd_C_BE_str[] MEM_TYPE = "C_BE";
+    #ifdef SW_HFE_SWEEP
+      const unsigned char Cmd_HFE_SWEEP_str[] MEM_TYPE = "HFE_SWEEP";
+    #endif
+    #ifdef SW_DIODE_CURVE
+      const unsigned char Cmd_D_CURVE_str[] MEM_TYPE = "D_CURVE";
+    #endif
+    #ifdef SW_SCR_CURRENTS
+      const unsigned char Cmd_I_LATCH_str[] MEM_TYPE = "I_LATCH";
+      const unsigned char Cmd_I_HOLD_str[] MEM_TYPE = "I_HOLD";
+    #endif
 
     /* command reference table */
     const Cmd_Type Cmd_Table[] MEM_TYPE = {
@@ -445,6 +509,17 @@
         {CMD_V_F_CLAMP, Cmd_V_F_clamp_str},
       #endif
       {CMD_C_BE, Cmd_C_BE_str},
+      #ifdef SW_HFE_SWEEP
+        {CMD_HFE_SWEEP, Cmd_HFE_SWEEP_str},
+      #endif
+      #ifdef SW_DIODE_CURVE
+        {CMD_D_CURVE, Cmd_D_CURVE_str},
+      #endif
+      #ifdef SW_SCR_CURRENTS
+        {CMD_I_GT, I_GT_str},
+        {CMD_I_LATCH, Cmd_I_LATCH_str},
+        {CMD_I_HOLD, Cmd_I_HOLD_str},
+      #endif
       {0, 0}
     };
   #endif
@@ -529,6 +604,25 @@
     const uint16_t Logic_Vcc_table[NUM_LOGIC_TYPES] MEM_TYPE = {5000, 3300, 5000, 9000, 12000, 15000};
   #endif
 
+  #if defined (SW_IR_RECEIVER) || defined (HW_IR_RECEIVER)
+    /* IR protocols with start sequence and PDM (times in 50s) */
+    /* start: pulse, pause, control for pulse and pause / data: spacer, 0, 1, control, bits / flags / address, command, extra: start bit and bits / name */
+    /* order sets priority, number of entries has to match IR_CAND_MAX */
+    const IR_PDM_Type IR_PDM_Table[] MEM_TYPE = {
+      {179,  89, IR_RELAX_LONG, IR_RELAX_LONG, 11, 11, 33, IR_STD_TOLER, 32, IR_TAB_EXT_INV, 1, 8, 17, 8, 9, 8, IR_NEC_str},
+      #ifdef SW_IR_RX_EXTRA
+      {179,  89, IR_RELAX_LONG, IR_RELAX_LONG, 11, 11, 33, IR_STD_TOLER, 42, 0, 1, 8, 27, 8, 9, 5, IR_Sanyo_str},
+      #endif
+      {168,  84, IR_STD_TOLER, IR_STD_TOLER, 11, 11, 32, IR_STD_TOLER, 16, 0, 1, 8, 9, 8, 0, 0, IR_JVC_str},
+      {184,  84, IR_RELAX_LONG, IR_STD_TOLER, 11, 11, 32, IR_STD_TOLER, 16, 0, 1, 8, 9, 8, 0, 0, IR_JVC_str},
+      #ifdef SW_IR_RX_EXTRA
+      {79,   79, IR_RELAX_LONG, IR_RELAX_LONG, 10, 20, 40, IR_RELAX_SHORT, 24, IR_TAB_MSB | IR_TAB_TRAILING, 1, 4, 5, 8, 0, 0, IR_RCA_str},
+      #endif
+      {89,   89, IR_STD_TOLER, IR_STD_TOLER, 11, 11, 34, IR_STD_TOLER, 32, IR_TAB_BAD, 1, 8, 17, 8, 0, 0, IR_Samsung_str},
+      {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+    };
+  #endif
+
 
   /*
    *  tables of register bits for probe settings
@@ -600,6 +694,30 @@
     extern Inductor_Type Inductor;           /* inductor */
   #endif
 
+  #ifdef SW_REPEAT_TYPE
+    extern Learn_Type    LastComp;           /* last component */
+  #endif
+
+  #ifdef SW_HFE_SWEEP
+    extern Sweep_Type    HFE_Sweep[];        /* hFE sweep table */
+    extern uint8_t       HFE_Points;         /* number of valid points */
+  #endif
+
+  #ifdef SW_DIODE_CURVE
+    extern Curve_Type    DiodeCurve[];       /* diode I/V curve */
+    extern uint8_t       CurvePoints;        /* number of valid points */
+    extern Shockley_Type DiodeFit;           /* Shockley parameters */
+  #endif
+
+  #ifdef SW_SCR_CURRENTS
+    extern SCR_Type      SCR;                /* thyristor/TRIAC currents */
+  #endif
+
+  #if defined (FUNC_EVALUE) || defined (FUNC_COLORCODE) || defined (FUNC_EIA96)
+    extern uint16_t      ENorm_Value[];      /* E series cache: value */
+    extern uint8_t       ENorm_Index[];      /* E series cache: index */
+  #endif
+
   #ifdef UI_SERIAL_COMMANDS
     extern Info_Type     Info;               /* additional component data */
   #endif
@@ -639,6 +757,16 @@
     extern const Touch_Type   NV_Touch;
   #endif
 
+  #ifdef SW_IR_LEARN
+    /* learned IR codes */
+    extern const IR_Slot_Type NV_IR_Slots[];
+  #endif
+
+  #ifdef SW_BINNING
+    /* binning reference */
+    extern const Bin_Type     NV_Bin;
+  #endif
+
 
   /*
    *  constant strings
@@ -827,6 +955,9 @@
     extern const unsigned char IR_SIRC_12_str[];
     extern const unsigned char IR_SIRC_15_str[];
     extern const unsigned char IR_SIRC_20_str[];
+    #ifdef SW_IR_LEARN
+      extern const unsigned char IR_Raw_str[];
+    #endif
   #endif
 
   #ifdef SW_OPTO_COUPLER
@@ -872,6 +1003,14 @@
     extern const unsigned char CapDischarge_str[];
   #endif
 
+  #ifdef SW_WAVEFORM
+    extern const unsigned char Waveform_str[];
+  #endif
+
+  #ifdef SW_BINNING
+    extern const unsigned char Binning_str[];
+  #endif
+
   #ifdef SW_MONITOR_R
     extern const unsigned char Monitor_R_str[];
   #endif
@@ -953,6 +1092,22 @@
     extern const unsigned char INA226_str[];
   #endif
 
+  #ifdef SW_DIODE_CURVE
+    extern const unsigned char R_s_str[];
+    extern const unsigned char Schottky_str[];
+    extern const unsigned char Silicon_str[];
+    extern const unsigned char LED_IR_str[];
+    extern const unsigned char LED_Red_str[];
+    extern const unsigned char LED_YG_str[];
+    extern const unsigned char LED_BW_str[];
+  #endif
+
+  #ifdef SW_SCR_CURRENTS
+    extern const unsigned char I_GT_str[];
+    extern const unsigned char I_Latch_str[];
+    extern const unsigned char I_Hold_str[];
+  #endif
+
 
   /* component symbols */
   extern const unsigned char Diode_AC_str[];
@@ -1018,6 +1173,16 @@
       extern const unsigned char Cmd_V_Z_str[];
     #endif
     extern const unsigned char Cmd_C_BE_str[];
+    #ifdef SW_HFE_SWEEP
+      extern const unsigned char Cmd_HFE_SWEEP_str[];
+    #endif
+    #ifdef SW_DIODE_CURVE
+      extern const unsigned char Cmd_D_CURVE_str[];
+    #endif
+    #ifdef SW_SCR_CURRENTS
+      extern const unsigned char Cmd_I_LATCH_str[];
+      extern const unsigned char Cmd_I_HOLD_str[];
+    #endif
 
     /* command reference table */
     extern const Cmd_Type Cmd_Table[];
@@ -1094,6 +1259,11 @@
     extern const uint16_t Logic_Vcc_table[];
   #endif
 
+  #if defined (SW_IR_RECEIVER) || defined (HW_IR_RECEIVER)
+    /* IR protocols with start sequence and PDM */
+    extern const IR_PDM_Type IR_PDM_Table[];
+  #endif
+
 
   /*
    *  tables of register bits for probe settings